@@ -19,6 +19,7 @@ public class InventorySystem : ModuleRules
 				"UMG",
 				"Core",
 				"Engine",
+				"NetCore",
 				"CoreUObject",
 				"InputCore",
 				"Slate",
@@ -4,6 +4,9 @@
 
 #include <functional>
 #include "InventorySystem.h"
+#include "ItemDropSubsystem.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerState.h"
 #include "Net/UnrealNetwork.h"
 #include "Engine/AssetManager.h"
 #include "AssetRegistry/AssetData.h"
@@ -88,32 +91,37 @@ void UInventorySystemComponent::GetLifetimeReplicatedProps(TArray<FLifetimePrope
 	DOREPLIFETIME_CONDITION_NOTIFY(UInventorySystemComponent, EquipmentTypes, COND_None, REPNOTIFY_Always);
 	DOREPLIFETIME_CONDITION_NOTIFY(UInventorySystemComponent, EquipmentTypeIndices, COND_None, REPNOTIFY_Always);
 	DOREPLIFETIME(UInventorySystemComponent, MaxEquipmentStackSize);
+	DOREPLIFETIME_CONDITION(UInventorySystemComponent, EquipmentLoadouts, COND_OwnerOnly);
 }
 
 void UInventorySystemComponent::OnRep_EquipmentTypeIndices(TArray<int> OldEquipmentTypeIndices)
 {
+	RebuildEquipmentCompatibilityIndex();
+
 	// Check for changes in the array
 	for (int Index = 0; Index < EquipmentTypeIndices.Num(); Index++)
 	{
 		// Check if index was added
 		if (OldEquipmentTypeIndices.Find(EquipmentTypeIndices[Index]) == INDEX_NONE || EquipmentTypeIndices[Index] != OldEquipmentTypeIndices[Index])
 		{
-			ChangedEquipmentSlotsDelegate.Broadcast({EquipmentTypeIndices[Index]});
+			BroadcastChangedEquipmentSlots({EquipmentTypeIndices[Index]});
 		}
 	}
 
 	for (int Index = 0; Index < OldEquipmentTypeIndices.Num(); Index++)
 	{
 		// Check if index was removed
-		if (EquipmentTypeIndices.Find(OldEquipmentTypeIndices[Index]) == INDEX_NONE)
+		if (FindEquipmentTypeIndex(OldEquipmentTypeIndices[Index]) == INDEX_NONE)
 		{
-			ChangedEquipmentSlotsDelegate.Broadcast({OldEquipmentTypeIndices[Index]});
+			BroadcastChangedEquipmentSlots({OldEquipmentTypeIndices[Index]});
 		}
 	}
 }
 
 void UInventorySystemComponent::OnRep_EquipmentTypes(TArray<FPrimaryAssetId> OldEquipmentTypes)
 {
+	RebuildEquipmentCompatibilityIndex();
+
 	// Check for changes in the array
 	for (int Index = 0; Index < EquipmentTypes.Num(); Index++)
 	{
@@ -122,7 +130,7 @@ void UInventorySystemComponent::OnRep_EquipmentTypes(TArray<FPrimaryAssetId> Old
 			// Check if index was added or changed
 			if (!OldEquipmentTypes.IsValidIndex(Index) || EquipmentTypes[Index] != OldEquipmentTypes[Index])
 			{
-				ChangedEquipmentSlotsDelegate.Broadcast({EquipmentTypeIndices[Index]});
+				BroadcastChangedEquipmentSlots({EquipmentTypeIndices[Index]});
 			}	
 		}
 	}
@@ -136,16 +144,16 @@ void UInventorySystemComponent::OnRep_EquipmentIndices(TArray<int> OldEquipmentI
 		// Check if index was added
 		if (OldEquipmentIndices.Find(EquipmentIndices[Index]) == INDEX_NONE || EquipmentIndices[Index] != OldEquipmentIndices[Index])
 		{
-			ChangedEquipmentSlotsDelegate.Broadcast({EquipmentIndices[Index]});
+			BroadcastChangedEquipmentSlots({EquipmentIndices[Index]});
 		}
 	}
 
 	for (int Index = 0; Index < OldEquipmentIndices.Num(); Index++)
 	{
 		// Check if index was removed
-		if (EquipmentIndices.Find(OldEquipmentIndices[Index]) == INDEX_NONE)
+		if (FindEquipmentIndex(OldEquipmentIndices[Index]) == INDEX_NONE)
 		{
-			ChangedEquipmentSlotsDelegate.Broadcast({OldEquipmentIndices[Index]});
+			BroadcastChangedEquipmentSlots({OldEquipmentIndices[Index]});
 		}
 	}
 }
@@ -160,7 +168,7 @@ void UInventorySystemComponent::OnRep_EquipmentAssets(TArray<FPrimaryAssetId> Ol
 			// Check if index was added or changed
 			if (!OldEquipmentAssets.IsValidIndex(Index) || EquipmentAssets[Index] != OldEquipmentAssets[Index])
 			{
-				ChangedEquipmentSlotsDelegate.Broadcast({EquipmentIndices[Index]});
+				BroadcastChangedEquipmentSlots({EquipmentIndices[Index]});
 			}	
 		}
 	}
@@ -176,7 +184,7 @@ void UInventorySystemComponent::OnRep_EquipmentAmounts(TArray<int> OldEquipmentA
 			// Check if index was added or changed
 			if (!OldEquipmentAmounts.IsValidIndex(Index) || EquipmentAmounts[Index] != OldEquipmentAmounts[Index])
 			{
-				ChangedEquipmentSlotsDelegate.Broadcast({EquipmentIndices[Index]});
+				BroadcastChangedEquipmentSlots({EquipmentIndices[Index]});
 			}
 		}
 	}
@@ -187,12 +195,12 @@ void UInventorySystemComponent::OnRep_EquipmentDynamicStatsIndices(TArray<int> O
 	// Check for changes in the array
 	for (int Index = 0; Index < EquipmentDynamicStatsIndices.Num(); Index++)
 	{
-		if (const int RealEquipmentIndex = EquipmentIndices.Find(EquipmentDynamicStatsIndices[Index]); RealEquipmentIndex != INDEX_NONE)
+		if (const int RealEquipmentIndex = FindEquipmentIndex(EquipmentDynamicStatsIndices[Index]); RealEquipmentIndex != INDEX_NONE)
 		{
 			// Check if index was added
 			if (OldEquipmentDynamicStatsIndices.Find(EquipmentDynamicStatsIndices[Index]) == INDEX_NONE || EquipmentDynamicStatsIndices[Index] != OldEquipmentDynamicStatsIndices[Index])
 			{
-				ChangedEquipmentSlotsDelegate.Broadcast({EquipmentIndices[RealEquipmentIndex]});
+				BroadcastChangedEquipmentSlots({EquipmentIndices[RealEquipmentIndex]});
 			}
 		}
 	}
@@ -200,32 +208,24 @@ void UInventorySystemComponent::OnRep_EquipmentDynamicStatsIndices(TArray<int> O
 	for (int Index = 0; Index < OldEquipmentDynamicStatsIndices.Num(); Index++)
 	{
 		// Check if index was removed
-		if (EquipmentDynamicStatsIndices.Find(OldEquipmentDynamicStatsIndices[Index]) == INDEX_NONE)
+		if (FindEquipmentDynamicStatsIndex(OldEquipmentDynamicStatsIndices[Index]) == INDEX_NONE)
 		{
-			ChangedEquipmentSlotsDelegate.Broadcast({OldEquipmentDynamicStatsIndices[Index]});
+			BroadcastChangedEquipmentSlots({OldEquipmentDynamicStatsIndices[Index]});
 		}
 	}
 }
 
 void UInventorySystemComponent::OnRep_EquipmentDynamicStats(TArray<FItemProperties> OldEquipmentDynamicStats)
 {
-	// Check for changes in the array
+	// Check for changes in the array. Index is the position in EquipmentDynamicStatsIndices, not the slot
 	for (int Index = 0; Index < EquipmentDynamicStats.Num(); Index++)
 	{
-		if (!OldEquipmentDynamicStats.IsValidIndex(Index))
-		{
-			continue;
-		}
-		
-		if (const int* RealEquipmentDynamicStatsSlot = EquipmentDynamicStatsIndices.FindByKey(Index); RealEquipmentDynamicStatsSlot != nullptr)
+		if (EquipmentDynamicStatsIndices.IsValidIndex(Index))
 		{
-			if (const int RealEquipmentIndex = EquipmentIndices.Find(*RealEquipmentDynamicStatsSlot); RealEquipmentIndex != INDEX_NONE)
+			// Check if index was added or changed
+			if (!OldEquipmentDynamicStats.IsValidIndex(Index) || EquipmentDynamicStats[Index] != OldEquipmentDynamicStats[Index])
 			{
-				// Check if value changed
-				if (EquipmentDynamicStats[Index] != OldEquipmentDynamicStats[Index])
-				{
-					ChangedEquipmentSlotsDelegate.Broadcast({EquipmentIndices[RealEquipmentIndex]});
-				}		
+				BroadcastChangedEquipmentSlots({EquipmentDynamicStatsIndices[Index]});
 			}
 		}
 	}
@@ -826,6 +826,16 @@ void UInventorySystemComponent::BeginPlay()
 		return;
 	}
 
+	// Keep the equipment compatibility index in sync with inventory changes
+	AssetEquipmentTypesCache.Reset();
+	ChangedInventorySlotsDelegate.AddDynamic(this, &UInventorySystemComponent::UpdateEquipmentCompatibilityIndex);
+	RebuildEquipmentCompatibilityIndex();
+
+	// Aggregate equipment stats only for changed equipment slots
+	AssetBaseStatsCache.Reset();
+	ChangedEquipmentSlotsDelegate.AddDynamic(this, &UInventorySystemComponent::UpdateEquipmentStatTotals);
+	RebuildEquipmentStatTotals();
+
 #if WITH_EDITORONLY_DATA
 	EquipmentDataAssets.Empty();
 	EquipmentDataAssetTypes.Empty();
@@ -853,9 +863,9 @@ TArray<FEquipmentSlot> UInventorySystemComponent::GetEquipmentSlots() const
 	TArray<FEquipmentSlot> EquipmentSlots;
 	for (const int Slot : EquipmentTypeIndices)
 	{
-		if (FEquipmentSlot NewSlot = GetEquipmentSlot(Slot); NewSlot.Slot != INDEX_NONE)
+		if (FEquipmentSlot NewSlot = GetCachedEquipmentSlot(Slot); NewSlot.Slot != INDEX_NONE)
 		{
-			EquipmentSlots.Add(NewSlot);
+			EquipmentSlots.Add(MoveTemp(NewSlot));
 			continue;
 		}
 
@@ -868,12 +878,90 @@ TArray<FEquipmentSlot> UInventorySystemComponent::GetEquipmentSlots() const
 
 FEquipmentSlot UInventorySystemComponent::GetEquipmentSlot(const int Slot) const
 {
-	UAssetManager* Manager = UAssetManager::GetIfInitialized();
-	const FName AssetRegistrySearchableEquipmentTypePropertyName = GET_MEMBER_NAME_CHECKED(UItemEquipmentDataAsset, EquipmentType);
+	return GetCachedEquipmentSlot(Slot);
+}
+
+FEquipmentSlot UInventorySystemComponent::GetCachedEquipmentSlot(const int Slot) const
+{
+	if (const FEquipmentSlot* CachedSlot = FindCachedEquipmentSlot(Slot))
+	{
+		return *CachedSlot;
+	}
+
+	return BuildEquipmentSlot(Slot);
+}
+
+const FEquipmentSlot* UInventorySystemComponent::FindCachedEquipmentSlot(const int Slot) const
+{
+	FEquipmentSlotRecord* Record = GetEquipmentSlotRecord(Slot);
+	if (!Record)
+	{
+		return nullptr;
+	}
+
+	if (Record->CachedGeneration != Record->Generation)
+	{
+		Record->CachedSlot = BuildEquipmentSlot(Slot);
+
+		// Slots built before the AssetManager is ready are incomplete. Build them again next time
+		if (const UAssetManager* Manager = UAssetManager::GetIfInitialized(); Manager && Manager->IsInitialized())
+		{
+			Record->CachedGeneration = Record->Generation;
+		}
+	}
+
+	return &Record->CachedSlot;
+}
+
+int UInventorySystemComponent::GetEquipmentSlotGeneration(const int Slot) const
+{
+	const FEquipmentSlotRecord* Record = GetEquipmentSlotRecord(Slot);
+	return Record ? Record->Generation : INDEX_NONE;
+}
+
+void UInventorySystemComponent::BroadcastChangedEquipmentSlots(const TArray<int>& Slots)
+{
+	for (const int Slot : Slots)
+	{
+		if (FEquipmentSlotRecord* Record = GetEquipmentSlotRecord(Slot))
+		{
+			Record->Generation++;
+		}
+	}
+
+	ChangedEquipmentSlotsDelegate.Broadcast(Slots);
+
+	for (const int Slot : Slots)
+	{
+		// Broadcast a copy. Subscribers may subscribe other slots and reallocate the map
+		if (const FSlotSubscriptionDelegate* Subscribers = EquipmentSlotSubscriptions.Find(Slot))
+		{
+			const FSlotSubscriptionDelegate SubscribersCopy = *Subscribers;
+			SubscribersCopy.Broadcast(Slot);
+		}
+	}
+}
+
+FDelegateHandle UInventorySystemComponent::SubscribeEquipmentSlot(const int Slot, FSlotSubscriptionDelegate::FDelegate&& Delegate)
+{
+	return EquipmentSlotSubscriptions.FindOrAdd(Slot).Add(MoveTemp(Delegate));
+}
+
+void UInventorySystemComponent::UnsubscribeEquipmentSlot(const int Slot, const FDelegateHandle& Handle)
+{
+	if (FSlotSubscriptionDelegate* Subscribers = EquipmentSlotSubscriptions.Find(Slot))
+	{
+		// Keep the entry. Removing it could destroy a delegate that is currently broadcasting
+		Subscribers->Remove(Handle);
+	}
+}
 
+FEquipmentSlot UInventorySystemComponent::BuildEquipmentSlot(const int Slot) const
+{
+	const UAssetManager* Manager = UAssetManager::GetIfInitialized();
 	if (!Manager->IsInitialized())
 	{
-		UE_LOG(InventorySystem, Error, TEXT("[UInventorySystemComponent|%s][GetEquipmentSlot]: AssetManager is not initialized"), *GetFName().ToString());
+		UE_LOG(InventorySystem, Error, TEXT("[UInventorySystemComponent|%s][BuildEquipmentSlot]: AssetManager is not initialized"), *GetFName().ToString());
 		return FEquipmentSlot{};
 	}
 
@@ -883,39 +971,23 @@ FEquipmentSlot UInventorySystemComponent::GetEquipmentSlot(const int Slot) const
 	FItemProperties DynamicStats;
 	int NewAmount = INDEX_NONE;
 	
-	if (const int RealEquipmentTypeIndex = EquipmentTypeIndices.Find(Slot); RealEquipmentTypeIndex !=INDEX_NONE)
+	if (const int RealEquipmentTypeIndex = FindEquipmentTypeIndex(Slot); RealEquipmentTypeIndex !=INDEX_NONE)
 	{
 		NewSlot = Slot;
-		if (const int RealEquipmentIndex = EquipmentIndices.Find(Slot); RealEquipmentIndex != INDEX_NONE)
+		if (const int RealEquipmentIndex = FindEquipmentIndex(Slot); RealEquipmentIndex != INDEX_NONE)
 		{
-			if (const int RealEquipmentDynamicStatsIndex = EquipmentDynamicStatsIndices.Find(Slot); RealEquipmentDynamicStatsIndex != INDEX_NONE)
+			if (const int RealEquipmentDynamicStatsIndex = FindEquipmentDynamicStatsIndex(Slot); RealEquipmentDynamicStatsIndex != INDEX_NONE)
 			{
 				if (!EquipmentDynamicStats.IsValidIndex(RealEquipmentDynamicStatsIndex))
 				{
-					UE_LOG(InventorySystem, Error, TEXT("[UInventorySystemComponent|%s][GetEquipmentSlot]: EquipmentDynamicStats is not filled but has an EquipmentDynamicStatsIndices entry"), *GetFName().ToString());
+					UE_LOG(InventorySystem, Error, TEXT("[UInventorySystemComponent|%s][BuildEquipmentSlot]: EquipmentDynamicStats is not filled but has an EquipmentDynamicStatsIndices entry"), *GetFName().ToString());
 					return FEquipmentSlot{};
 				}
 			
 				DynamicStats = EquipmentDynamicStats[RealEquipmentDynamicStatsIndex];
 			}
 
-			FAssetData CurrentItemData;
-			Manager->GetPrimaryAssetData(EquipmentAssets[RealEquipmentIndex], CurrentItemData);
-		
-			FAssetDataTagMapSharedView::FFindTagResult EquipmentTypesTagValue = CurrentItemData.TagsAndValues.FindTag(AssetRegistrySearchableEquipmentTypePropertyName);
-
-			if (EquipmentTypesTagValue.IsSet())
-			{
-				TArray<FString> AssetEquipmentTypeStrings{};
-				UE_LOG(InventorySystem, Log, TEXT("[UInventorySystemComponent|%s][GetEquipmentSlot]: %s"), *GetFName().ToString(), *EquipmentTypesTagValue.GetValue());
-				FString AssetEquipmentTypeBaseString = ReplaceEquipmentArrayString(EquipmentTypesTagValue.GetValue());
-				AssetEquipmentTypeBaseString.ParseIntoArray(AssetEquipmentTypeStrings, TEXT(","));
-				for (FString AssetEquipmentTypeString : AssetEquipmentTypeStrings)
-				{
-					NewEquipmentTypes.Add(FPrimaryAssetId(AssetEquipmentTypeString));
-				}
-			}
-			
+			NewEquipmentTypes = GetAssetEquipmentTypes(EquipmentAssets[RealEquipmentIndex]);
 			NewAsset = EquipmentAssets[RealEquipmentIndex];
 			NewAmount = EquipmentAmounts[RealEquipmentIndex];
 		}	
@@ -924,6 +996,415 @@ FEquipmentSlot UInventorySystemComponent::GetEquipmentSlot(const int Slot) const
 	return FEquipmentSlot{NewEquipmentTypes, NewSlot, NewAsset, DynamicStats, NewAmount};
 }
 
+int UInventorySystemComponent::FindCachedEquipmentIndex(const TArray<int>& Indices, int& CachedIndex, const int Slot)
+{
+	if (Indices.IsValidIndex(CachedIndex) && Indices[CachedIndex] == Slot)
+	{
+		return CachedIndex;
+	}
+
+	CachedIndex = Indices.Find(Slot);
+	return CachedIndex;
+}
+
+UInventorySystemComponent::FEquipmentSlotRecord* UInventorySystemComponent::GetEquipmentSlotRecord(const int Slot) const
+{
+	if (EquipmentSlotRecords.IsValidIndex(Slot))
+	{
+		return &EquipmentSlotRecords[Slot];
+	}
+
+	return SparseEquipmentSlotRecords.Find(Slot);
+}
+
+void UInventorySystemComponent::ResizeEquipmentSlotRecords()
+{
+	int MaxSlot = INDEX_NONE;
+	for (const int Slot : EquipmentTypeIndices)
+	{
+		if (Slot >= 0 && Slot < MaxDenseEquipmentSlotRecords)
+		{
+			MaxSlot = FMath::Max(MaxSlot, Slot);
+		}
+	}
+
+	if (MaxSlot + 1 > EquipmentSlotRecords.Num())
+	{
+		EquipmentSlotRecords.SetNum(MaxSlot + 1);
+	}
+
+	// Sparse records are only kept for configured slots, so the map stays as small as EquipmentTypeIndices
+	for (TMap<int, FEquipmentSlotRecord>::TIterator It = SparseEquipmentSlotRecords.CreateIterator(); It; ++It)
+	{
+		if (!EquipmentTypeIndices.Contains(It.Key()))
+		{
+			It.RemoveCurrent();
+		}
+	}
+
+	for (const int Slot : EquipmentTypeIndices)
+	{
+		if (Slot < 0 || Slot >= MaxDenseEquipmentSlotRecords)
+		{
+			SparseEquipmentSlotRecords.FindOrAdd(Slot);
+		}
+	}
+}
+
+int UInventorySystemComponent::FindEquipmentTypeIndex(const int Slot) const
+{
+	FEquipmentSlotRecord* Record = GetEquipmentSlotRecord(Slot);
+	return Record ? FindCachedEquipmentIndex(EquipmentTypeIndices, Record->TypeIndex, Slot) : EquipmentTypeIndices.Find(Slot);
+}
+
+int UInventorySystemComponent::FindEquipmentIndex(const int Slot) const
+{
+	FEquipmentSlotRecord* Record = GetEquipmentSlotRecord(Slot);
+	return Record ? FindCachedEquipmentIndex(EquipmentIndices, Record->ItemIndex, Slot) : EquipmentIndices.Find(Slot);
+}
+
+int UInventorySystemComponent::FindEquipmentDynamicStatsIndex(const int Slot) const
+{
+	FEquipmentSlotRecord* Record = GetEquipmentSlotRecord(Slot);
+	return Record ? FindCachedEquipmentIndex(EquipmentDynamicStatsIndices, Record->DynamicStatsIndex, Slot) : EquipmentDynamicStatsIndices.Find(Slot);
+}
+
+TArray<FPrimaryAssetId> UInventorySystemComponent::GetAssetEquipmentTypes(const FPrimaryAssetId& Asset) const
+{
+	if (const TArray<FPrimaryAssetId>* CachedEquipmentTypes = AssetEquipmentTypesCache.Find(Asset))
+	{
+		return *CachedEquipmentTypes;
+	}
+
+	TArray<FPrimaryAssetId> AssetEquipmentTypes;
+	const UAssetManager* Manager = UAssetManager::GetIfInitialized();
+	if (!Manager || !Manager->IsInitialized() || !Asset.IsValid())
+	{
+		return AssetEquipmentTypes;
+	}
+
+	// Only cache valid lookups. The asset may not be registered yet
+	FAssetData AssetData;
+	if (!Manager->GetPrimaryAssetData(Asset, AssetData) || !AssetData.IsValid())
+	{
+		return AssetEquipmentTypes;
+	}
+
+	if (FAssetDataTagMapSharedView::FFindTagResult TagValue = AssetData.TagsAndValues.FindTag(GET_MEMBER_NAME_CHECKED(UItemEquipmentDataAsset, EquipmentType)); TagValue.IsSet())
+	{
+		TArray<FString> AssetEquipmentTypeStrings{};
+		FString AssetEquipmentTypeBaseString = ReplaceEquipmentArrayString(TagValue.GetValue());
+		AssetEquipmentTypeBaseString.ParseIntoArray(AssetEquipmentTypeStrings, TEXT(","));
+		for (FString AssetEquipmentTypeString : AssetEquipmentTypeStrings)
+		{
+			AssetEquipmentTypes.Add(FPrimaryAssetId(AssetEquipmentTypeString));
+		}
+	}
+
+	AssetEquipmentTypesCache.Add(Asset, AssetEquipmentTypes);
+	return AssetEquipmentTypes;
+}
+
+TArray<int> UInventorySystemComponent::GetCompatibleEquipmentSlots(const FPrimaryAssetId& Asset) const
+{
+	const TArray<FPrimaryAssetId> AssetEquipmentTypes = GetAssetEquipmentTypes(Asset);
+	if (AssetEquipmentTypes.Num() == 1)
+	{
+		const TArray<int>* EquipmentSlots = EquipmentSlotsByEquipmentType.Find(AssetEquipmentTypes[0]);
+		return EquipmentSlots ? *EquipmentSlots : TArray<int>{};
+	}
+
+	TArray<int> CompatibleEquipmentSlots;
+	for (const FPrimaryAssetId& AssetEquipmentType : AssetEquipmentTypes)
+	{
+		if (const TArray<int>* EquipmentSlots = EquipmentSlotsByEquipmentType.Find(AssetEquipmentType))
+		{
+			for (const int EquipmentSlot : *EquipmentSlots)
+			{
+				CompatibleEquipmentSlots.AddUnique(EquipmentSlot);
+			}
+		}
+	}
+
+	// Keep the EquipmentTypes order across multiple types
+	CompatibleEquipmentSlots.Sort([this](const int First, const int Second)
+	{
+		return FindEquipmentTypeIndex(First) < FindEquipmentTypeIndex(Second);
+	});
+
+	return CompatibleEquipmentSlots;
+}
+
+TArray<int> UInventorySystemComponent::GetCompatibleInventorySlots(const int EquipmentSlot)
+{
+	if (CompatibleEquipmentSlotsByInventorySlot.Num() != InventoryIndices.Num())
+	{
+		RebuildEquipmentCompatibilityIndex();
+	}
+
+	const TArray<int>* InventorySlots = CompatibleInventorySlotsByEquipmentSlot.Find(EquipmentSlot);
+	if (!InventorySlots)
+	{
+		return {};
+	}
+
+	TArray<int> CompatibleInventorySlots = *InventorySlots;
+	CompatibleInventorySlots.Sort();
+	return CompatibleInventorySlots;
+}
+
+void UInventorySystemComponent::RebuildEquipmentCompatibilityIndex()
+{
+	ResizeEquipmentSlotRecords();
+
+	EquipmentSlotsByEquipmentType.Reset();
+	CompatibleInventorySlotsByEquipmentSlot.Reset();
+	CompatibleEquipmentSlotsByInventorySlot.Reset();
+
+	for (int I = 0; I < EquipmentTypeIndices.Num() && I < EquipmentTypes.Num(); I++)
+	{
+		if (EquipmentTypes[I].IsValid() && EquipmentTypes[I] != FPrimaryAssetId{})
+		{
+			EquipmentSlotsByEquipmentType.FindOrAdd(EquipmentTypes[I]).Add(EquipmentTypeIndices[I]);
+		}
+	}
+
+	for (const int Slot : InventoryIndices)
+	{
+		UpdateEquipmentCompatibilityIndexSlot(Slot);
+	}
+}
+
+void UInventorySystemComponent::UpdateEquipmentCompatibilityIndex(const TArray<int>& Slots)
+{
+	for (const int Slot : Slots)
+	{
+		UpdateEquipmentCompatibilityIndexSlot(Slot);
+	}
+}
+
+void UInventorySystemComponent::UpdateEquipmentCompatibilityIndexSlot(const int Slot)
+{
+	TArray<int> OldEquipmentSlots;
+	if (CompatibleEquipmentSlotsByInventorySlot.RemoveAndCopyValue(Slot, OldEquipmentSlots))
+	{
+		for (const int EquipmentSlot : OldEquipmentSlots)
+		{
+			if (TArray<int>* InventorySlots = CompatibleInventorySlotsByEquipmentSlot.Find(EquipmentSlot))
+			{
+				InventorySlots->RemoveSingleSwap(Slot);
+			}
+		}
+	}
+
+	const int RealInventoryIndex = InventoryIndices.Find(Slot);
+	if (RealInventoryIndex == INDEX_NONE || !InventoryAssets.IsValidIndex(RealInventoryIndex))
+	{
+		return;
+	}
+
+	// Every occupied slot gets an entry, so the entry count matches the inventory
+	TArray<int>& EquipmentSlots = CompatibleEquipmentSlotsByInventorySlot.Add(Slot, GetCompatibleEquipmentSlots(InventoryAssets[RealInventoryIndex]));
+	for (const int EquipmentSlot : EquipmentSlots)
+	{
+		CompatibleInventorySlotsByEquipmentSlot.FindOrAdd(EquipmentSlot).Add(Slot);
+	}
+}
+
+FItemProperties UInventorySystemComponent::GetAssetBaseStats(const FPrimaryAssetId& Asset) const
+{
+	if (const FItemProperties* CachedBaseStats = AssetBaseStatsCache.Find(Asset))
+	{
+		return *CachedBaseStats;
+	}
+
+	FItemProperties AssetBaseStats;
+	const UAssetManager* Manager = UAssetManager::GetIfInitialized();
+	if (!Manager || !Manager->IsInitialized() || !Asset.IsValid())
+	{
+		return AssetBaseStats;
+	}
+
+	// Only cache valid lookups. The asset may not be registered yet
+	FAssetData AssetData;
+	if (!Manager->GetPrimaryAssetData(Asset, AssetData) || !AssetData.IsValid())
+	{
+		return AssetBaseStats;
+	}
+
+	if (FAssetDataTagMapSharedView::FFindTagResult TagValue = AssetData.TagsAndValues.FindTag(GET_MEMBER_NAME_CHECKED(UItemEquipmentDataAsset, BaseStats)); TagValue.IsSet())
+	{
+		const FString BaseStatsString = TagValue.GetValue();
+		if (!FItemProperties::StaticStruct()->ImportText(*BaseStatsString, &AssetBaseStats, nullptr, PPF_None, nullptr, FItemProperties::StaticStruct()->GetName()))
+		{
+			UE_LOG(InventorySystem, Warning, TEXT("[UInventorySystemComponent|%s][GetAssetBaseStats]: Could not parse base stats of %s"), *GetFName().ToString(), *Asset.ToString());
+			AssetBaseStats = FItemProperties{};
+		}
+	}
+
+	AssetBaseStatsCache.Add(Asset, AssetBaseStats);
+	return AssetBaseStats;
+}
+
+double UInventorySystemComponent::GetEquipmentStatTotal(const FName PropertyName) const
+{
+	const double* Total = EquipmentStatTotals.Find(PropertyName);
+	return Total ? *Total : 0.0;
+}
+
+double UInventorySystemComponent::GetEquipmentStatMax(const FName PropertyName) const
+{
+	const double* Max = EquipmentStatMaxes.Find(PropertyName);
+	return Max ? *Max : 0.0;
+}
+
+TMap<FName, double> UInventorySystemComponent::GetEquipmentStatTotals() const
+{
+	return EquipmentStatTotals;
+}
+
+TMap<FName, double> UInventorySystemComponent::CalculateEquipmentSlotStats(const int Slot) const
+{
+	const int RealEquipmentIndex = FindEquipmentIndex(Slot);
+	if (RealEquipmentIndex == INDEX_NONE || !EquipmentAssets.IsValidIndex(RealEquipmentIndex) || !EquipmentAssets[RealEquipmentIndex].IsValid())
+	{
+		return {};
+	}
+
+	TMap<FName, double> SlotStats;
+	const std::function AddNumericStats = [&SlotStats](const FItemProperties& Stats)
+	{
+		for (const FItemProperty& ItemProperty : Stats.ItemProperties)
+		{
+			if (ItemProperty.Value.IsNumeric())
+			{
+				SlotStats.FindOrAdd(ItemProperty.Name) += FCString::Atod(*ItemProperty.Value.ToString());
+			}
+		}
+	};
+
+	AddNumericStats(GetAssetBaseStats(EquipmentAssets[RealEquipmentIndex]));
+	if (const int RealEquipmentDynamicStatsIndex = FindEquipmentDynamicStatsIndex(Slot); EquipmentDynamicStats.IsValidIndex(RealEquipmentDynamicStatsIndex))
+	{
+		AddNumericStats(EquipmentDynamicStats[RealEquipmentDynamicStatsIndex]);
+	}
+
+	return SlotStats;
+}
+
+void UInventorySystemComponent::RebuildEquipmentStatTotals()
+{
+	EquipmentStatsBySlot.Reset();
+	EquipmentStatTotals.Reset();
+	EquipmentStatMaxes.Reset();
+
+	for (const int Slot : EquipmentIndices)
+	{
+		TMap<FName, double> SlotStats = CalculateEquipmentSlotStats(Slot);
+		for (const TPair<FName, double>& Stat : SlotStats)
+		{
+			EquipmentStatTotals.FindOrAdd(Stat.Key) += Stat.Value;
+			if (const double* Max = EquipmentStatMaxes.Find(Stat.Key); !Max || Stat.Value > *Max)
+			{
+				EquipmentStatMaxes.Add(Stat.Key, Stat.Value);
+			}
+		}
+
+		if (!SlotStats.IsEmpty())
+		{
+			EquipmentStatsBySlot.Add(Slot, MoveTemp(SlotStats));
+		}
+	}
+}
+
+void UInventorySystemComponent::UpdateEquipmentStatTotals(const TArray<int>& Slots)
+{
+	TMap<FName, double> Deltas;
+	TSet<FName> DirtyMaxes;
+	TArray<int> ChangedSlots;
+
+	for (const int Slot : Slots)
+	{
+		if (ChangedSlots.Contains(Slot))
+		{
+			continue;
+		}
+
+		TMap<FName, double> NewStats = CalculateEquipmentSlotStats(Slot);
+		TMap<FName, double> OldStats;
+		EquipmentStatsBySlot.RemoveAndCopyValue(Slot, OldStats);
+		if (OldStats.OrderIndependentCompareEqual(NewStats))
+		{
+			if (!NewStats.IsEmpty())
+			{
+				EquipmentStatsBySlot.Add(Slot, MoveTemp(NewStats));
+			}
+			continue;
+		}
+
+		ChangedSlots.Add(Slot);
+		for (const TPair<FName, double>& Stat : OldStats)
+		{
+			Deltas.FindOrAdd(Stat.Key) -= Stat.Value;
+
+			// Removing the current highest value requires a new search for this stat
+			if (const double* Max = EquipmentStatMaxes.Find(Stat.Key); Max && Stat.Value >= *Max)
+			{
+				DirtyMaxes.Add(Stat.Key);
+			}
+		}
+
+		for (const TPair<FName, double>& Stat : NewStats)
+		{
+			Deltas.FindOrAdd(Stat.Key) += Stat.Value;
+			if (const double* Max = EquipmentStatMaxes.Find(Stat.Key); !Max || Stat.Value > *Max)
+			{
+				EquipmentStatMaxes.Add(Stat.Key, Stat.Value);
+			}
+		}
+
+		if (!NewStats.IsEmpty())
+		{
+			EquipmentStatsBySlot.Add(Slot, MoveTemp(NewStats));
+		}
+	}
+
+	if (ChangedSlots.IsEmpty())
+	{
+		return;
+	}
+
+	for (const TPair<FName, double>& Delta : Deltas)
+	{
+		EquipmentStatTotals.FindOrAdd(Delta.Key) += Delta.Value;
+	}
+
+	// Equipment slots are few. Only stats which lost their highest value are searched again
+	for (const FName& StatName : DirtyMaxes)
+	{
+		TOptional<double> NewMax;
+		for (const TPair<int, TMap<FName, double>>& SlotStats : EquipmentStatsBySlot)
+		{
+			if (const double* Value = SlotStats.Value.Find(StatName); Value && (!NewMax.IsSet() || *Value > NewMax.GetValue()))
+			{
+				NewMax = *Value;
+			}
+		}
+
+		if (NewMax.IsSet())
+		{
+			EquipmentStatMaxes.Add(StatName, NewMax.GetValue());
+			continue;
+		}
+
+		// No equipped item has this stat anymore
+		EquipmentStatMaxes.Remove(StatName);
+		EquipmentStatTotals.Remove(StatName);
+	}
+
+	ChangedEquipmentStatTotalsDelegate.Broadcast(ChangedSlots, Deltas);
+}
+
 bool UInventorySystemComponent::SetEquipmentType_Validate(const int Slot, const FPrimaryAssetId EquipmentType)
 {
 	return true;
@@ -938,6 +1419,13 @@ void UInventorySystemComponent::SetEquipmentType_Implementation(const int Slot,
 		return;
 	}
 
+	if (const UInventorySystemSettings* InventorySettings = GetMutableDefault<UInventorySystemSettings>(); Slot < 0 || Slot > InventorySettings->MaxEquipmentSlot)
+	{
+		UE_LOG(InventorySystem, Error, TEXT("[UInventorySystemComponent|%s][SetEquipmentType]: Slot %d is out of range"), *GetFName().ToString(), Slot);
+		SetEquipmentTypeFailureDelegate.Broadcast(Slot, EquipmentType);
+		return;
+	}
+
 	if (bIsProcessing)
 	{
 		UE_LOG(InventorySystem, Error, TEXT("[UInventorySystemComponent|%s][SetEquipmentType]: Component is still processing previous request"), *GetFName().ToString());
@@ -957,7 +1445,7 @@ void UInventorySystemComponent::SetEquipmentType_Implementation(const int Slot,
 	}
 
 	// Check slot valid
-	const int RealEquipmentTypeIndices = EquipmentTypeIndices.Find(Slot);
+	const int RealEquipmentTypeIndices = FindEquipmentTypeIndex(Slot);
 	TArray<int> ChangedSlots;
 	if (RealEquipmentTypeIndices == INDEX_NONE)
 	{
@@ -971,8 +1459,9 @@ void UInventorySystemComponent::SetEquipmentType_Implementation(const int Slot,
 
 		EquipmentTypeIndices.AddUnique(Slot);
 		EquipmentTypes.Add(EquipmentType);
+		RebuildEquipmentCompatibilityIndex();
 		SetEquipmentTypeSuccessDelegate.Broadcast(Slot);
-		ChangedEquipmentSlotsDelegate.Broadcast({Slot});
+		BroadcastChangedEquipmentSlots({Slot});
 		bIsProcessing = false;
 		return;
 	}
@@ -1002,18 +1491,20 @@ void UInventorySystemComponent::SetEquipmentType_Implementation(const int Slot,
 	{
 		EquipmentTypes.RemoveAt(RealEquipmentTypeIndices);
 		EquipmentTypeIndices.RemoveAt(RealEquipmentTypeIndices);
+		RebuildEquipmentCompatibilityIndex();
 
 		SetEquipmentTypeSuccessDelegate.Broadcast(Slot);
-		ChangedEquipmentSlotsDelegate.Broadcast({Slot});
+		BroadcastChangedEquipmentSlots({Slot});
 		ChangedInventorySlotsDelegate.Broadcast(ChangedSlots);
 		bIsProcessing = false;
 		return;
 	}
 
 	EquipmentTypes[RealEquipmentTypeIndices] = EquipmentType;
+	RebuildEquipmentCompatibilityIndex();
 
 	SetEquipmentTypeSuccessDelegate.Broadcast(Slot);
-	ChangedEquipmentSlotsDelegate.Broadcast({Slot});
+	BroadcastChangedEquipmentSlots({Slot});
 	ChangedInventorySlotsDelegate.Broadcast(ChangedSlots);
 	bIsProcessing = false;
 }
@@ -1033,7 +1524,7 @@ bool UInventorySystemComponent::HasItemProperty(const int Slot, const FName Name
 		return false;
 	}
 
-	if (const int EquipmentDynamicStatsIndex = EquipmentDynamicStatsIndices.Find(Slot); EquipmentDynamicStatsIndex != INDEX_NONE && EquipmentDynamicStats.IsValidIndex(EquipmentDynamicStatsIndex))
+	if (const int EquipmentDynamicStatsIndex = FindEquipmentDynamicStatsIndex(Slot); EquipmentDynamicStatsIndex != INDEX_NONE && EquipmentDynamicStats.IsValidIndex(EquipmentDynamicStatsIndex))
 	{
 		for (const TArray<FItemProperty>* DynamicStatsItemProperties = &EquipmentDynamicStats[EquipmentDynamicStatsIndex].ItemProperties; const FItemProperty& ItemProperty : *DynamicStatsItemProperties)
 		{
@@ -1057,13 +1548,13 @@ FItemProperty UInventorySystemComponent::GetItemProperty(const int Slot, const F
 		return Super::GetItemProperty(Slot, Name, bIsEquipment);
 	}
 
-	if (const int Index = EquipmentIndices.Find(Slot); Index == INDEX_NONE || Name.IsNone())
+	if (const int Index = FindEquipmentIndex(Slot); Index == INDEX_NONE || Name.IsNone())
 	{
 		UE_LOG(InventorySystem, Error, TEXT("[UInventorySystemComponent|%s][GetItemProperty]: Data invalid for equipment slot: %d"), *GetFName().ToString(), Slot);
 		return {};
 	}
 
-	if (const int EquipmentDynamicStatsIndex = EquipmentDynamicStatsIndices.Find(Slot); EquipmentDynamicStatsIndex != INDEX_NONE && EquipmentDynamicStats.IsValidIndex(EquipmentDynamicStatsIndex))
+	if (const int EquipmentDynamicStatsIndex = FindEquipmentDynamicStatsIndex(Slot); EquipmentDynamicStatsIndex != INDEX_NONE && EquipmentDynamicStats.IsValidIndex(EquipmentDynamicStatsIndex))
 	{
 		for (const TArray<FItemProperty>* DynamicStatsItemProperties = &EquipmentDynamicStats[EquipmentDynamicStatsIndex].ItemProperties; const FItemProperty& ItemProperty : *DynamicStatsItemProperties)
 		{
@@ -1104,7 +1595,7 @@ void UInventorySystemComponent::SetSlotAmount_Implementation(const int Slot, con
 	bIsProcessing = true;
 
 	// Equipment
-	if (const int AmountIndex = EquipmentIndices.Find(Slot); AmountIndex != INDEX_NONE && EquipmentAssets.IsValidIndex(AmountIndex) && Amount > 0 && Amount <= GetEquipmentStackSizeConfig())
+	if (const int AmountIndex = FindEquipmentIndex(Slot); AmountIndex != INDEX_NONE && EquipmentAssets.IsValidIndex(AmountIndex) && Amount > 0 && Amount <= GetEquipmentStackSizeConfig())
 	{
 		bool TempCanStack = false;
 		const UAssetManager* Manager = UAssetManager::GetIfInitialized();
@@ -1140,7 +1631,7 @@ void UInventorySystemComponent::SetSlotAmount_Implementation(const int Slot, con
 		}
 
 		SetSlotAmountSuccessDelegate.Broadcast(true, Slot, bIsEquipment);
-		ChangedEquipmentSlotsDelegate.Broadcast({Slot});
+		BroadcastChangedEquipmentSlots({Slot});
 		bIsProcessing = false;
 		return;
 	}
@@ -1173,8 +1664,8 @@ void UInventorySystemComponent::SetSlotItemProperty_Implementation(const int Slo
 
 	bIsProcessing = true;
 
-	const int EquipmentDynamicStatsIndex = EquipmentDynamicStatsIndices.Find(Slot);
-	if (const int EquipmentIndex = EquipmentIndices.Find(Slot); EquipmentIndex == INDEX_NONE || Name.IsNone())
+	const int EquipmentDynamicStatsIndex = FindEquipmentDynamicStatsIndex(Slot);
+	if (const int EquipmentIndex = FindEquipmentIndex(Slot); EquipmentIndex == INDEX_NONE || Name.IsNone())
 	{
 		UE_LOG(InventorySystem, Error, TEXT("[UInventorySystemComponent|%s][SetSlotItemProperty]: Equipment data invalid for slot %d"), *GetFName().ToString(), Slot);
 		SetSlotItemPropertySuccessDelegate.Broadcast(false, Slot, bIsEquipment);
@@ -1199,7 +1690,7 @@ void UInventorySystemComponent::SetSlotItemProperty_Implementation(const int Slo
 
 		EquipmentDynamicStats.Add(FItemProperties{NewItemProperties});
 		SetSlotItemPropertySuccessDelegate.Broadcast(true, Slot, bIsEquipment);
-		ChangedEquipmentSlotsDelegate.Broadcast({Slot});
+		BroadcastChangedEquipmentSlots({Slot});
 		bIsProcessing = false;
 		return;
 	}
@@ -1227,7 +1718,7 @@ void UInventorySystemComponent::SetSlotItemProperty_Implementation(const int Slo
 			ItemProperty.Value = Value;
 			ItemProperty.DisplayName = DisplayName;
 			SetSlotItemPropertySuccessDelegate.Broadcast(true, Slot, bIsEquipment);
-			ChangedEquipmentSlotsDelegate.Broadcast({Slot});
+			BroadcastChangedEquipmentSlots({Slot});
 			bIsProcessing = false;
 			return;
 		}
@@ -1242,14 +1733,14 @@ void UInventorySystemComponent::SetSlotItemProperty_Implementation(const int Slo
 			EquipmentDynamicStats.RemoveAt(EquipmentDynamicStatsIndex);
 		}
 		SetSlotItemPropertySuccessDelegate.Broadcast(true, Slot, bIsEquipment);
-		ChangedEquipmentSlotsDelegate.Broadcast({Slot});
+		BroadcastChangedEquipmentSlots({Slot});
 		bIsProcessing = false;
 		return;	
 	}
 
 	EquipmentDynamicStats[EquipmentDynamicStatsIndex].ItemProperties.Add(FItemProperty{Name, DisplayName, Value});
 	SetSlotItemPropertySuccessDelegate.Broadcast(true, Slot, bIsEquipment);
-	ChangedEquipmentSlotsDelegate.Broadcast({Slot});
+	BroadcastChangedEquipmentSlots({Slot});
 	bIsProcessing = false;
 }
 
@@ -1276,21 +1767,21 @@ void UInventorySystemComponent::SwapItems_Implementation(const int First, const
 
 	bIsProcessing = true;
 
-	const int FirstIndex = EquipmentIndices.Find(First);
-	const int SecondIndex = EquipmentIndices.Find(Second);
+	const int FirstIndex = FindEquipmentIndex(First);
+	const int SecondIndex = FindEquipmentIndex(Second);
 
 	const UAssetManager* Manager = UAssetManager::GetIfInitialized();
 	if ((FirstIndex == INDEX_NONE && SecondIndex == INDEX_NONE) || !Manager->IsInitialized() || !EquipmentTypeIndices.Contains(First) || !EquipmentTypeIndices.Contains(Second))
 	{
 		UE_LOG(InventorySystem, Error, TEXT("[UInventorySystemComponent|%s][SwapItems]: AssetManager is not initialized or item data is invalid"), *GetFName().ToString());
 		SwapItemSuccessDelegate.Broadcast(false, First, Second, bIsEquipment);
-		ChangedEquipmentSlotsDelegate.Broadcast({First, Second});
+		BroadcastChangedEquipmentSlots({First, Second});
 		bIsProcessing = false;
 		return;
 	}
 
-	const int RealFirstEquipmentTypeIndex = EquipmentTypeIndices.Find(First);
-	const int RealSecondEquipmentTypeIndex = EquipmentTypeIndices.Find(Second);
+	const int RealFirstEquipmentTypeIndex = FindEquipmentTypeIndex(First);
+	const int RealSecondEquipmentTypeIndex = FindEquipmentTypeIndex(Second);
 
 	if (RealFirstEquipmentTypeIndex == INDEX_NONE || RealSecondEquipmentTypeIndex == INDEX_NONE || !EquipmentTypes.IsValidIndex(RealFirstEquipmentTypeIndex) || !EquipmentTypes.IsValidIndex(RealSecondEquipmentTypeIndex))
 	{
@@ -1300,10 +1791,9 @@ void UInventorySystemComponent::SwapItems_Implementation(const int First, const
 		return;
 	}
 
-	const FName AssetRegistrySearchableEquipmentTypePropertyName = GET_MEMBER_NAME_CHECKED(UItemEquipmentDataAsset, EquipmentType);
 
-	const int RealFirstEquipmentStatsIndex = EquipmentDynamicStatsIndices.Find(First);
-	const int RealSecondEquipmentStatsIndex = EquipmentDynamicStatsIndices.Find(Second);
+	const int RealFirstEquipmentStatsIndex = FindEquipmentDynamicStatsIndex(First);
+	const int RealSecondEquipmentStatsIndex = FindEquipmentDynamicStatsIndex(Second);
 
 	if ((RealFirstEquipmentStatsIndex != INDEX_NONE && !EquipmentDynamicStats.IsValidIndex(RealFirstEquipmentStatsIndex)) || (RealSecondEquipmentStatsIndex != INDEX_NONE && !EquipmentDynamicStats.
 		IsValidIndex(RealSecondEquipmentStatsIndex)))
@@ -1394,7 +1884,7 @@ void UInventorySystemComponent::SwapItems_Implementation(const int First, const
 					}
 
 					SwapItemSuccessDelegate.Broadcast(true, First, Second, bIsEquipment);
-					ChangedEquipmentSlotsDelegate.Broadcast({First, Second});
+					BroadcastChangedEquipmentSlots({First, Second});
 					bIsProcessing = false;
 					return;
 				}
@@ -1405,41 +1895,15 @@ void UInventorySystemComponent::SwapItems_Implementation(const int First, const
 					EquipmentAmounts[FirstIndex] = AmountLeft;
 
 					SwapItemSuccessDelegate.Broadcast(true, First, Second, bIsEquipment);
-					ChangedEquipmentSlotsDelegate.Broadcast({First, Second});
+					BroadcastChangedEquipmentSlots({First, Second});
 					bIsProcessing = false;
 					return;
 				}	
 			}
 		}
 
-		TArray<FPrimaryAssetId> FirstAssetEquipmentType{};
-		FAssetDataTagMapSharedView::FFindTagResult FirstTagValue = FirstAssetData.TagsAndValues.FindTag(AssetRegistrySearchableEquipmentTypePropertyName);
-		TArray<FPrimaryAssetId> SecondAssetEquipmentType{};
-		FAssetDataTagMapSharedView::FFindTagResult SecondTagValue = SecondAssetData.TagsAndValues.FindTag(AssetRegistrySearchableEquipmentTypePropertyName);
-
-		if (FirstTagValue.IsSet())
-		{
-			TArray<FString> AssetEquipmentTypeStrings{};
-			UE_LOG(InventorySystem, Log, TEXT("[UInventorySystemComponent|%s][SwapItems]: %s"), *GetFName().ToString(), *FirstTagValue.GetValue());
-			FString AssetEquipmentTypeBaseString = ReplaceEquipmentArrayString(FirstTagValue.GetValue());
-			AssetEquipmentTypeBaseString.ParseIntoArray(AssetEquipmentTypeStrings, TEXT(","));
-			for (FString AssetEquipmentTypeString : AssetEquipmentTypeStrings)
-			{
-				FirstAssetEquipmentType.Add(FPrimaryAssetId(AssetEquipmentTypeString));
-			}
-		}
-
-		if (SecondTagValue.IsSet())
-		{
-			TArray<FString> AssetEquipmentTypeStrings{};
-			UE_LOG(InventorySystem, Log, TEXT("[UInventorySystemComponent|%s][SwapItems]: %s"), *GetFName().ToString(), *SecondTagValue.GetValue());
-			FString AssetEquipmentTypeBaseString = ReplaceEquipmentArrayString(SecondTagValue.GetValue());
-			AssetEquipmentTypeBaseString.ParseIntoArray(AssetEquipmentTypeStrings, TEXT(","));
-			for (FString AssetEquipmentTypeString : AssetEquipmentTypeStrings)
-			{
-				SecondAssetEquipmentType.Add(FPrimaryAssetId(AssetEquipmentTypeString));
-			}
-		}
+		const TArray<FPrimaryAssetId> FirstAssetEquipmentType = GetAssetEquipmentTypes(EquipmentAssets[FirstIndex]);
+		const TArray<FPrimaryAssetId> SecondAssetEquipmentType = GetAssetEquipmentTypes(EquipmentAssets[SecondIndex]);
 
 		if (FirstAssetEquipmentType.IsEmpty() || SecondAssetEquipmentType.IsEmpty())
 		{
@@ -1468,7 +1932,7 @@ void UInventorySystemComponent::SwapItems_Implementation(const int First, const
 			}
 
 			SwapItemSuccessDelegate.Broadcast(true, First, Second, bIsEquipment);
-			ChangedEquipmentSlotsDelegate.Broadcast({First, Second});
+			BroadcastChangedEquipmentSlots({First, Second});
 			bIsProcessing = false;
 			return;
 		}
@@ -1492,22 +1956,7 @@ void UInventorySystemComponent::SwapItems_Implementation(const int First, const
 			return;
 		}
 
-		TArray<FPrimaryAssetId> FirstAssetEquipmentType{};
-		FAssetDataTagMapSharedView::FFindTagResult FirstTagValue = FirstAssetData.TagsAndValues.FindTag(AssetRegistrySearchableEquipmentTypePropertyName);
-		if (FirstTagValue.IsSet())
-		{
-			TArray<FString> AssetEquipmentTypeStrings{};
-			UE_LOG(InventorySystem, Log, TEXT("[UInventorySystemComponent|%s][SwapItems]: %s"), *GetFName().ToString(), *FirstTagValue.GetValue());
-			FString AssetEquipmentTypeBaseString = FirstTagValue.GetValue();
-			AssetEquipmentTypeBaseString = AssetEquipmentTypeBaseString.Replace(TEXT("("), TEXT(""));
-			AssetEquipmentTypeBaseString = AssetEquipmentTypeBaseString.Replace(TEXT(")"), TEXT(""));
-			AssetEquipmentTypeBaseString = AssetEquipmentTypeBaseString.Replace(TEXT("\""), TEXT(""));
-			AssetEquipmentTypeBaseString.ParseIntoArray(AssetEquipmentTypeStrings, TEXT(","));
-			for (FString AssetEquipmentTypeString : AssetEquipmentTypeStrings)
-			{
-				FirstAssetEquipmentType.Add(FPrimaryAssetId(AssetEquipmentTypeString));
-			}
-		}
+		const TArray<FPrimaryAssetId> FirstAssetEquipmentType = GetAssetEquipmentTypes(EquipmentAssets[FirstIndex]);
 
 		if (FirstAssetEquipmentType.IsEmpty())
 		{
@@ -1532,7 +1981,7 @@ void UInventorySystemComponent::SwapItems_Implementation(const int First, const
 		}
 
 		SwapItemSuccessDelegate.Broadcast(true, First, Second, bIsEquipment);
-		ChangedEquipmentSlotsDelegate.Broadcast({First, Second});
+		BroadcastChangedEquipmentSlots({First, Second});
 		bIsProcessing = false;
 		return;
 	}
@@ -1550,22 +1999,7 @@ void UInventorySystemComponent::SwapItems_Implementation(const int First, const
 			return;
 		}
 
-		TArray<FPrimaryAssetId> SecondAssetEquipmentType{};
-		FAssetDataTagMapSharedView::FFindTagResult SecondTagValue = SecondAssetData.TagsAndValues.FindTag(AssetRegistrySearchableEquipmentTypePropertyName);
-		if (SecondTagValue.IsSet())
-		{
-			TArray<FString> AssetEquipmentTypeStrings{};
-			UE_LOG(InventorySystem, Log, TEXT("[UInventorySystemComponent|%s][SwapItems]: %s"), *GetFName().ToString(), *SecondTagValue.GetValue());
-			FString AssetEquipmentTypeBaseString = SecondTagValue.GetValue();
-			AssetEquipmentTypeBaseString = AssetEquipmentTypeBaseString.Replace(TEXT("("), TEXT(""));
-			AssetEquipmentTypeBaseString = AssetEquipmentTypeBaseString.Replace(TEXT(")"), TEXT(""));
-			AssetEquipmentTypeBaseString = AssetEquipmentTypeBaseString.Replace(TEXT("\""), TEXT(""));
-			AssetEquipmentTypeBaseString.ParseIntoArray(AssetEquipmentTypeStrings, TEXT(","));
-			for (FString AssetEquipmentTypeString : AssetEquipmentTypeStrings)
-			{
-				SecondAssetEquipmentType.Add(FPrimaryAssetId(AssetEquipmentTypeString));
-			}
-		}
+		const TArray<FPrimaryAssetId> SecondAssetEquipmentType = GetAssetEquipmentTypes(EquipmentAssets[SecondIndex]);
 
 		if (SecondAssetEquipmentType.IsEmpty())
 		{
@@ -1590,7 +2024,7 @@ void UInventorySystemComponent::SwapItems_Implementation(const int First, const
 		}
 
 		SwapItemSuccessDelegate.Broadcast(true, First, Second, bIsEquipment);
-		ChangedEquipmentSlotsDelegate.Broadcast({First, Second});
+		BroadcastChangedEquipmentSlots({First, Second});
 		bIsProcessing = false;
 		return;
 	}
@@ -1606,28 +2040,33 @@ bool UInventorySystemComponent::PickUpItemDrop_Validate(AItemDrop* const& Item,
 }
 
 void UInventorySystemComponent::PickUpItemDrop_Implementation(AItemDrop* const& Item, const bool bCanStack)
+{
+	PickUpItemDropDirect(Item, bCanStack);
+}
+
+bool UInventorySystemComponent::PickUpItemDropDirect(AItemDrop* Item, const bool bCanStack)
 {
 	if (!IsValid(Item))
 	{
-		UE_LOG(InventorySystem, Error, TEXT("[UItemContainerComponent|%s][PickUpItemDrop]: Item invalid"), *GetFName().ToString());
+		UE_LOG(InventorySystem, Error, TEXT("[UItemContainerComponent|%s][PickUpItemDropDirect]: Item invalid"), *GetFName().ToString());
 		PickUpItemFailureDelegate.Broadcast(Item);
-		return;
+		return false;
 	}
 
 	if (const AActor* Owner = GetOwner(); !IsValid(Owner) || !Owner->HasAuthority())
 	{
-		UE_LOG(InventorySystem, Error, TEXT("[UItemContainerComponent|%s][PickUpItemDrop]: Component owner has no authority"), *GetFName().ToString());
+		UE_LOG(InventorySystem, Error, TEXT("[UItemContainerComponent|%s][PickUpItemDropDirect]: Component owner has no authority"), *GetFName().ToString());
 		PickUpItemFailureDelegate.Broadcast(Item);
 		Item->AfterPickUpEvent(false);
-		return;
+		return false;
 	}
 
 	if (bIsProcessing)
 	{
-		UE_LOG(InventorySystem, Error, TEXT("[UInventorySystemComponent|%s][PickUpItemDrop]: Component is still processing previous request"), *GetFName().ToString());
+		UE_LOG(InventorySystem, Error, TEXT("[UInventorySystemComponent|%s][PickUpItemDropDirect]: Component is still processing previous request"), *GetFName().ToString());
 		PickUpItemFailureDelegate.Broadcast(Item);
 		Item->AfterPickUpEvent(false);
-		return;
+		return false;
 	}
 
 	bIsProcessing = true;
@@ -1639,23 +2078,24 @@ void UInventorySystemComponent::PickUpItemDrop_Implementation(AItemDrop* const&
 		PickUpItemFailureDelegate.Broadcast(Item);
 		Item->AfterPickUpEvent(false);
 		bIsProcessing = false;
-		return;
+		return false;
 	}
 
 	if (!AllAdded)
 	{
-		UE_LOG(InventorySystem, Warning, TEXT("[UInventorySystemComponent|%s][PickUpItemDrop]: Part of the item was added. Not enough space to add all"), *GetFName().ToString());
+		UE_LOG(InventorySystem, Warning, TEXT("[UInventorySystemComponent|%s][PickUpItemDropDirect]: Part of the item was added. Not enough space to add all"), *GetFName().ToString());
 		PickUpItemSuccessDelegate.Broadcast(Item, ChangedSlots);
 		ChangedInventorySlotsDelegate.Broadcast(ChangedSlots);
 		Item->AfterPickUpEvent(true);
 		bIsProcessing = false;
-		return;
+		return true;
 	}
 
 	PickUpItemSuccessDelegate.Broadcast(Item, ChangedSlots);
 	ChangedInventorySlotsDelegate.Broadcast(ChangedSlots);
 	Item->AfterPickUpEvent(true);
 	bIsProcessing = false;
+	return true;
 }
 
 bool UInventorySystemComponent::PickUpItemDropInternal(AItemDrop* const& Item, const bool bCanStack, TArray<int>& ChangedSlots)
@@ -1709,35 +2149,193 @@ bool UInventorySystemComponent::PickUpItemDropInternal(AItemDrop* const& Item, c
 		}
 	}
 
-	bool bSuccess = false;
-	FindNextEmptySlot(Index, bSuccess);
-	if (bSuccess)
+	bool bSuccess = false;
+	FindNextEmptySlot(Index, bSuccess);
+	if (bSuccess)
+	{
+		const int ItemsLeft = Item->Amount - GetStackSizeConfig();
+		InventoryIndices.Add(Index);
+		InventoryAssets.Add(Item->InventoryAsset);
+		ChangedSlots.Add(Index);
+		if (!Item->DynamicStats.ItemProperties.IsEmpty())
+		{
+			InventoryDynamicStatsIndices.Add(Index);
+			InventoryDynamicStats.Add(Item->DynamicStats);
+		}
+
+		if (ItemsLeft > 0)
+		{
+			// Try to add item again to ensure all items are taken
+			InventoryAmounts.Add(GetStackSizeConfig());
+			Item->Amount = ItemsLeft;
+			return PickUpItemDropInternal(Item, bCanStack, ChangedSlots);
+		}
+
+		InventoryAmounts.Add(Item->Amount);
+		Item->Amount = 0;
+		return true;
+	}
+
+	UE_LOG(InventorySystem, Error, TEXT("[UInventorySystemComponent|%s][PickUpItemDrop]: Item could not be added. Unexpected behavior"), *GetFName().ToString());
+	return false;
+}
+
+bool UInventorySystemComponent::PickUpItemDropsInRadius_Validate(const float Radius, const FItemDropQuery Query, const bool bCanStack)
+{
+	return FMath::IsFinite(Radius);
+}
+
+void UInventorySystemComponent::PickUpItemDropsInRadius_Implementation(const float Radius, const FItemDropQuery Query, const bool bCanStack)
+{
+	if (const AActor* Owner = GetOwner(); !IsValid(Owner) || !Owner->HasAuthority())
+	{
+		UE_LOG(InventorySystem, Error, TEXT("[UInventorySystemComponent|%s][PickUpItemDropsInRadius]: Component owner has no authority"), *GetFName().ToString());
+		PickUpItemDropsFailureDelegate.Broadcast(Radius);
+		return;
+	}
+
+	if (bIsProcessing)
+	{
+		UE_LOG(InventorySystem, Error, TEXT("[UInventorySystemComponent|%s][PickUpItemDropsInRadius]: Component is still processing previous request"), *GetFName().ToString());
+		PickUpItemDropsFailureDelegate.Broadcast(Radius);
+		return;
+	}
+
+	const UItemDropSubsystem* ItemDropSubsystem = GetWorld()->GetSubsystem<UItemDropSubsystem>();
+	if (!IsValid(ItemDropSubsystem) || Radius <= 0.f)
+	{
+		UE_LOG(InventorySystem, Error, TEXT("[UInventorySystemComponent|%s][PickUpItemDropsInRadius]: ItemDropSubsystem is invalid or radius is out of range"), *GetFName().ToString());
+		PickUpItemDropsFailureDelegate.Broadcast(Radius);
+		return;
+	}
+
+	bIsProcessing = true;
+
+	// The radius comes from the client. Never search further than the project allows
+	const UInventorySystemSettings* InventorySettings = GetMutableDefault<UInventorySystemSettings>();
+	const float PickUpRadius = FMath::Min(Radius, InventorySettings->MaxItemDropPickUpRadius);
+
+	// Nearest drops first, so a full inventory keeps the drops further away
+	const FVector Location = GetPickUpLocation();
+	TArray<AItemDrop*> ItemDrops = ItemDropSubsystem->GetItemDropsInRadius(Location, PickUpRadius, Query);
+	ItemDrops.Sort([&Location](const AItemDrop& First, const AItemDrop& Second)
+	{
+		return FVector::DistSquared(First.GetActorLocation(), Location) < FVector::DistSquared(Second.GetActorLocation(), Location);
+	});
+
+	TArray<int> ChangedSlots;
+	TArray<AItemDrop*> PickedUpItemDrops;
+	for (AItemDrop* ItemDrop : ItemDrops)
+	{
+		// Drops picked up by another request are skipped
+		if (!IsValid(ItemDrop) || ItemDrop->IsProcessing())
+		{
+			continue;
+		}
+
+		TArray<int> ItemDropChangedSlots;
+		PickUpItemDropInternal(ItemDrop, bCanStack, ItemDropChangedSlots);
+		if (ItemDropChangedSlots.IsEmpty())
+		{
+			continue;
+		}
+
+		for (const int Slot : ItemDropChangedSlots)
+		{
+			ChangedSlots.AddUnique(Slot);
+		}
+		PickedUpItemDrops.Add(ItemDrop);
+	}
+
+	if (ChangedSlots.IsEmpty())
+	{
+		PickUpItemDropsFailureDelegate.Broadcast(Radius);
+		bIsProcessing = false;
+		return;
+	}
+
+	PickUpItemDropsSuccessDelegate.Broadcast(PickedUpItemDrops, ChangedSlots);
+	ChangedInventorySlotsDelegate.Broadcast(ChangedSlots);
+
+	// Destroy or update the drops after the inventory change was published
+	for (AItemDrop* ItemDrop : PickedUpItemDrops)
+	{
+		if (IsValid(ItemDrop))
+		{
+			ItemDrop->AfterPickUpEvent(true);
+		}
+	}
+
+	bIsProcessing = false;
+}
+
+bool UInventorySystemComponent::PickUpLightweightItemDrop_Validate(const int Id, const bool bCanStack)
+{
+	return true;
+}
+
+void UInventorySystemComponent::PickUpLightweightItemDrop_Implementation(const int Id, const bool bCanStack)
+{
+	if (const AActor* Owner = GetOwner(); !IsValid(Owner) || !Owner->HasAuthority())
+	{
+		UE_LOG(InventorySystem, Error, TEXT("[UInventorySystemComponent|%s][PickUpLightweightItemDrop]: Component owner has no authority"), *GetFName().ToString());
+		PickUpItemFailureDelegate.Broadcast(nullptr);
+		return;
+	}
+
+	if (bIsProcessing)
+	{
+		UE_LOG(InventorySystem, Error, TEXT("[UInventorySystemComponent|%s][PickUpLightweightItemDrop]: Component is still processing previous request"), *GetFName().ToString());
+		PickUpItemFailureDelegate.Broadcast(nullptr);
+		return;
+	}
+
+	UItemDropSubsystem* ItemDropSubsystem = GetWorld()->GetSubsystem<UItemDropSubsystem>();
+	FItemDropInstance ItemDropInstance;
+	if (!IsValid(ItemDropSubsystem) || !ItemDropSubsystem->FindLightweightItemDrop(Id, ItemDropInstance))
+	{
+		UE_LOG(InventorySystem, Warning, TEXT("[UInventorySystemComponent|%s][PickUpLightweightItemDrop]: Lightweight item drop %d does not exist"), *GetFName().ToString(), Id);
+		PickUpItemFailureDelegate.Broadcast(nullptr);
+		return;
+	}
+
+	// The id comes from the client. Only drops within the pick up radius can be picked up
+	if (const UInventorySystemSettings* InventorySettings = GetMutableDefault<UInventorySystemSettings>(); FVector::DistSquared(ItemDropInstance.Transform.GetLocation(), GetPickUpLocation()) > FMath::Square(InventorySettings->MaxItemDropPickUpRadius))
+	{
+		UE_LOG(InventorySystem, Warning, TEXT("[UInventorySystemComponent|%s][PickUpLightweightItemDrop]: Lightweight item drop %d is out of range"), *GetFName().ToString(), Id);
+		PickUpItemFailureDelegate.Broadcast(nullptr);
+		return;
+	}
+
+	AItemDrop* ItemDrop = ItemDropSubsystem->PromoteLightweightItemDrop(Id);
+	if (!IsValid(ItemDrop))
 	{
-		const int ItemsLeft = Item->Amount - GetStackSizeConfig();
-		InventoryIndices.Add(Index);
-		InventoryAssets.Add(Item->InventoryAsset);
-		ChangedSlots.Add(Index);
-		if (!Item->DynamicStats.ItemProperties.IsEmpty())
-		{
-			InventoryDynamicStatsIndices.Add(Index);
-			InventoryDynamicStats.Add(Item->DynamicStats);
-		}
+		UE_LOG(InventorySystem, Warning, TEXT("[UInventorySystemComponent|%s][PickUpLightweightItemDrop]: Lightweight item drop %d could not be promoted"), *GetFName().ToString(), Id);
+		PickUpItemFailureDelegate.Broadcast(nullptr);
+		return;
+	}
 
-		if (ItemsLeft > 0)
+	PickUpItemDropDirect(ItemDrop, bCanStack);
+
+	// Turn what is left back into a lightweight drop, so a failed or partial pick up does not leave an actor behind
+	if (IsValid(ItemDrop) && !ItemDrop->IsActorBeingDestroyed() && !ItemDrop->IsPooled() && ItemDrop->Amount > 0)
+	{
+		if (ItemDropSubsystem->AddLightweightItemDrop(ItemDrop->InventoryAsset, ItemDrop->Amount, ItemDrop->DynamicStats, ItemDrop->GetActorTransform()) != INDEX_NONE)
 		{
-			// Try to add item again to ensure all items are taken
-			InventoryAmounts.Add(GetStackSizeConfig());
-			Item->Amount = ItemsLeft;
-			return PickUpItemDropInternal(Item, bCanStack, ChangedSlots);
+			ItemDropSubsystem->ReleaseItemDrop(ItemDrop);
 		}
+	}
+}
 
-		InventoryAmounts.Add(Item->Amount);
-		Item->Amount = 0;
-		return true;
+FVector UInventorySystemComponent::GetPickUpLocation() const
+{
+	const AActor* Owner = GetOwner();
+	if (const APlayerState* PlayerState = Cast<APlayerState>(Owner); IsValid(PlayerState) && IsValid(PlayerState->GetPawn()))
+	{
+		return PlayerState->GetPawn()->GetActorLocation();
 	}
 
-	UE_LOG(InventorySystem, Error, TEXT("[UInventorySystemComponent|%s][PickUpItemDrop]: Item could not be added. Unexpected behavior"), *GetFName().ToString());
-	return false;
+	return IsValid(Owner) ? Owner->GetActorLocation() : FVector::ZeroVector;
 }
 
 bool UInventorySystemComponent::AddItemToEquipmentSlot_Validate(const FPrimaryAssetId InventoryAsset, const int EquipmentSlot, const FItemProperties DynamicStats, int Amount, const bool bCanUnequippedItemStack, const bool bCanStack)
@@ -1763,7 +2361,7 @@ void UInventorySystemComponent::AddItemToEquipmentSlot_Implementation(const FPri
 
 	bIsProcessing = true;
 
-	const int RealEquipmentTypeIndicesIndex = EquipmentTypeIndices.Find(EquipmentSlot);
+	const int RealEquipmentTypeIndicesIndex = FindEquipmentTypeIndex(EquipmentSlot);
 	if (!InventoryAsset.IsValid() || InventoryAsset == FPrimaryAssetId() || Amount <= 0 || RealEquipmentTypeIndicesIndex == INDEX_NONE || !EquipmentTypes.IsValidIndex(RealEquipmentTypeIndicesIndex) || !EquipmentTypes[
 		RealEquipmentTypeIndicesIndex].IsValid() || EquipmentTypes[RealEquipmentTypeIndicesIndex] == FPrimaryAssetId())
 	{
@@ -1799,21 +2397,9 @@ void UInventorySystemComponent::AddItemToEquipmentSlot_Implementation(const FPri
 	}
 
 	const FName AssetRegistrySearchablePropertyName = GET_MEMBER_NAME_CHECKED(UItemDataAsset, bCanStack);
-	const FName AssetRegistrySearchableEquipmentTypePropertyName = GET_MEMBER_NAME_CHECKED(UItemEquipmentDataAsset, EquipmentType);
 	AssetData.GetTagValue(AssetRegistrySearchablePropertyName, TempCanStack);
 
-	FAssetDataTagMapSharedView::FFindTagResult TagValue = AssetData.TagsAndValues.FindTag(AssetRegistrySearchableEquipmentTypePropertyName);
-	if (TagValue.IsSet())
-	{
-		TArray<FString> AssetEquipmentTypeStrings{};
-		UE_LOG(InventorySystem, Log, TEXT("[UInventorySystemComponent|%s][AddItemToEquipmentSlot]: %s"), *GetFName().ToString(), *TagValue.GetValue());
-		FString AssetEquipmentTypeBaseString = ReplaceEquipmentArrayString(TagValue.GetValue());
-		AssetEquipmentTypeBaseString.ParseIntoArray(AssetEquipmentTypeStrings, TEXT(","));
-		for (FString AssetEquipmentTypeString : AssetEquipmentTypeStrings)
-		{
-			AssetEquipmentType.Add(FPrimaryAssetId(AssetEquipmentTypeString));
-		}
-	}
+	AssetEquipmentType = GetAssetEquipmentTypes(InventoryAsset);
 
 	if (AssetEquipmentType.IsEmpty())
 	{
@@ -1831,7 +2417,7 @@ void UInventorySystemComponent::AddItemToEquipmentSlot_Implementation(const FPri
 		return;
 	}
 
-	if (const int RealEquipmentIndex = EquipmentIndices.Find(EquipmentSlot); RealEquipmentIndex != INDEX_NONE)
+	if (const int RealEquipmentIndex = FindEquipmentIndex(EquipmentSlot); RealEquipmentIndex != INDEX_NONE)
 	{
 		if (bCanStack && EquipmentAssets[RealEquipmentIndex] == InventoryAsset)
 		{
@@ -1848,13 +2434,13 @@ void UInventorySystemComponent::AddItemToEquipmentSlot_Implementation(const FPri
 					}
 					
 					AddItemToEquipmentSlotSuccessDelegate.Broadcast(EquipmentSlot, ChangedSlots, ItemAmount);
-					ChangedEquipmentSlotsDelegate.Broadcast({EquipmentSlot});
+					BroadcastChangedEquipmentSlots({EquipmentSlot});
 					ChangedInventorySlotsDelegate.Broadcast(ChangedSlots);
 					bIsProcessing = false;
 					return;
 				}
 				
-				const int RealEquipmentDynamicStatsIndex = EquipmentDynamicStatsIndices.Find(EquipmentSlot);
+				const int RealEquipmentDynamicStatsIndex = FindEquipmentDynamicStatsIndex(EquipmentSlot);
 				if ((RealEquipmentDynamicStatsIndex != INDEX_NONE && EquipmentDynamicStats[RealEquipmentDynamicStatsIndex] == DynamicStats) || (DynamicStats.ItemProperties.IsEmpty() && RealEquipmentDynamicStatsIndex == INDEX_NONE))
 				{
 					const int ClampedAmount = FMath::Clamp(EquipmentAmounts[RealEquipmentIndex] + Amount, 1, GetEquipmentStackSizeConfig());
@@ -1873,7 +2459,7 @@ void UInventorySystemComponent::AddItemToEquipmentSlot_Implementation(const FPri
 
 					// Success
 					AddItemToEquipmentSlotSuccessDelegate.Broadcast(EquipmentSlot, ChangedSlots, Overflow);
-					ChangedEquipmentSlotsDelegate.Broadcast({EquipmentSlot});
+					BroadcastChangedEquipmentSlots({EquipmentSlot});
 					ChangedInventorySlotsDelegate.Broadcast(ChangedSlots);
 					bIsProcessing = false;
 					return;
@@ -1898,7 +2484,7 @@ void UInventorySystemComponent::AddItemToEquipmentSlot_Implementation(const FPri
 			if (EquippedTempCanStack)
 			{
 				FItemProperties EquippedEquipmentDynamicStats;
-				if (const int RealEquipmentDynamicStatsIndex = EquipmentDynamicStatsIndices.Find(EquipmentSlot); RealEquipmentDynamicStatsIndex != INDEX_NONE)
+				if (const int RealEquipmentDynamicStatsIndex = FindEquipmentDynamicStatsIndex(EquipmentSlot); RealEquipmentDynamicStatsIndex != INDEX_NONE)
 				{
 					if (!EquipmentDynamicStats.IsValidIndex(RealEquipmentDynamicStatsIndex))
 					{
@@ -1940,7 +2526,7 @@ void UInventorySystemComponent::AddItemToEquipmentSlot_Implementation(const FPri
 			}
 			
 			// Unequip item to new slot
-			if (const int RealEquipmentDynamicStatsIndicesIndex = EquipmentDynamicStatsIndices.Find(EquipmentSlot); RealEquipmentDynamicStatsIndicesIndex != INDEX_NONE)
+			if (const int RealEquipmentDynamicStatsIndicesIndex = FindEquipmentDynamicStatsIndex(EquipmentSlot); RealEquipmentDynamicStatsIndicesIndex != INDEX_NONE)
 			{
 				if (!EquipmentDynamicStats.IsValidIndex(RealEquipmentDynamicStatsIndicesIndex))
 				{
@@ -1970,7 +2556,7 @@ void UInventorySystemComponent::AddItemToEquipmentSlot_Implementation(const FPri
 		}
 
 		// Equip if exits
-		if (const int RealEquipmentDynamicStatsIndicesIndex = EquipmentDynamicStatsIndices.Find(EquipmentSlot); RealEquipmentDynamicStatsIndicesIndex != INDEX_NONE)
+		if (const int RealEquipmentDynamicStatsIndicesIndex = FindEquipmentDynamicStatsIndex(EquipmentSlot); RealEquipmentDynamicStatsIndicesIndex != INDEX_NONE)
 		{
 			if (!EquipmentDynamicStats.IsValidIndex(RealEquipmentDynamicStatsIndicesIndex))
 			{
@@ -2026,7 +2612,7 @@ void UInventorySystemComponent::AddItemToEquipmentSlot_Implementation(const FPri
 		
 		AddItemToEquipmentSlotSuccessDelegate.Broadcast(EquipmentSlot, ChangedSlots, ItemAmount);
 		ChangedInventorySlotsDelegate.Broadcast(ChangedSlots);
-		ChangedEquipmentSlotsDelegate.Broadcast({EquipmentSlot});
+		BroadcastChangedEquipmentSlots({EquipmentSlot});
 		bIsProcessing = false;
 		return;
 	}
@@ -2065,7 +2651,7 @@ void UInventorySystemComponent::AddItemToEquipmentSlot_Implementation(const FPri
 	}
 	
 	AddItemToEquipmentSlotSuccessDelegate.Broadcast(EquipmentSlot, ChangedSlots, ItemAmount);
-	ChangedEquipmentSlotsDelegate.Broadcast({EquipmentSlot});
+	BroadcastChangedEquipmentSlots({EquipmentSlot});
 	ChangedInventorySlotsDelegate.Broadcast(ChangedSlots);
 	bIsProcessing = false;
 }
@@ -2078,7 +2664,6 @@ bool UInventorySystemComponent::RemoveEquipmentAmountFromSlot_Validate(const int
 void UInventorySystemComponent::RemoveEquipmentAmountFromSlot_Implementation(const int EquipmentSlot, const int Amount)
 {
 	UAssetManager* Manager = UAssetManager::GetIfInitialized();
-	const FName AssetRegistrySearchableEquipmentTypePropertyName = GET_MEMBER_NAME_CHECKED(UItemEquipmentDataAsset, EquipmentType);
 
 	if (!Manager->IsInitialized())
 	{
@@ -2104,7 +2689,7 @@ void UInventorySystemComponent::RemoveEquipmentAmountFromSlot_Implementation(con
 
 	bIsProcessing = true;
 
-	const int RealEquipmentIndex = EquipmentIndices.Find(EquipmentSlot);
+	const int RealEquipmentIndex = FindEquipmentIndex(EquipmentSlot);
 	if (Amount <= 0 || Amount > GetEquipmentStackSizeConfig() || RealEquipmentIndex == INDEX_NONE || !EquipmentAmounts.IsValidIndex(RealEquipmentIndex))
 	{
 		UE_LOG(InventorySystem, Error, TEXT("[UInventorySystemComponent|%s][RemoveEquipmentAmountFromSlot]: Equipment data invalid for slot %d"), *GetFName().ToString(), EquipmentSlot);
@@ -2128,7 +2713,7 @@ void UInventorySystemComponent::RemoveEquipmentAmountFromSlot_Implementation(con
 	const FPrimaryAssetId TempAsset = EquipmentAssets[RealEquipmentIndex];
 	int RealEquipmentStatsIndex = INDEX_NONE;
 	FItemProperties TempDynamicStats;
-	if (RealEquipmentStatsIndex = EquipmentDynamicStatsIndices.Find(EquipmentSlot); RealEquipmentStatsIndex != INDEX_NONE)
+	if (RealEquipmentStatsIndex = FindEquipmentDynamicStatsIndex(EquipmentSlot); RealEquipmentStatsIndex != INDEX_NONE)
 	{
 		if (!EquipmentDynamicStats.IsValidIndex(RealEquipmentStatsIndex))
 		{
@@ -2141,22 +2726,7 @@ void UInventorySystemComponent::RemoveEquipmentAmountFromSlot_Implementation(con
 		TempDynamicStats = EquipmentDynamicStats[RealEquipmentStatsIndex];
 	}
 
-	FAssetData CurrentItemData;
-	Manager->GetPrimaryAssetData(EquipmentAssets[RealEquipmentIndex], CurrentItemData);
-
-	FAssetDataTagMapSharedView::FFindTagResult EquipmentTypesTagValue = CurrentItemData.TagsAndValues.FindTag(AssetRegistrySearchableEquipmentTypePropertyName);
-
-	if (EquipmentTypesTagValue.IsSet())
-	{
-		TArray<FString> AssetEquipmentTypeStrings{};
-		UE_LOG(InventorySystem, Log, TEXT("[UInventorySystemComponent|%s][GetEquipmentSlot]: %s"), *GetFName().ToString(), *EquipmentTypesTagValue.GetValue());
-		FString AssetEquipmentTypeBaseString = ReplaceEquipmentArrayString(EquipmentTypesTagValue.GetValue());
-		AssetEquipmentTypeBaseString.ParseIntoArray(AssetEquipmentTypeStrings, TEXT(","));
-		for (FString AssetEquipmentTypeString : AssetEquipmentTypeStrings)
-		{
-			TempEquipmentTypes.Add(FPrimaryAssetId(AssetEquipmentTypeString));
-		}
-	}
+	TempEquipmentTypes = GetAssetEquipmentTypes(TempAsset);
 
 	if (NewAmount == 0)
 	{
@@ -2171,7 +2741,7 @@ void UInventorySystemComponent::RemoveEquipmentAmountFromSlot_Implementation(con
 
 		EquipmentIndices.RemoveAt(RealEquipmentIndex);
 		RemoveEquipmentAmountFromSlotSuccessDelegate.Broadcast(true, FEquipmentSlot{TempEquipmentTypes, EquipmentSlot, TempAsset, TempDynamicStats, TempAmount}, Amount);
-		ChangedEquipmentSlotsDelegate.Broadcast({EquipmentSlot});
+		BroadcastChangedEquipmentSlots({EquipmentSlot});
 		bIsProcessing = false;
 		return;
 	}
@@ -2179,7 +2749,7 @@ void UInventorySystemComponent::RemoveEquipmentAmountFromSlot_Implementation(con
 	EquipmentAmounts[RealEquipmentIndex] = NewAmount;
 
 	RemoveEquipmentAmountFromSlotSuccessDelegate.Broadcast(true, FEquipmentSlot{TempEquipmentTypes, EquipmentSlot, TempAsset, TempDynamicStats, TempAmount}, Amount);
-	ChangedEquipmentSlotsDelegate.Broadcast({EquipmentSlot});
+	BroadcastChangedEquipmentSlots({EquipmentSlot});
 	bIsProcessing = false;
 }
 
@@ -2225,7 +2795,6 @@ void UInventorySystemComponent::ItemEquipFromInventory_Implementation(const int
 	}
 
 	bool TempCanStack = false;
-	TArray<FPrimaryAssetId> AssetEquipmentType{};
 	FAssetData AssetData;
 	Manager->GetPrimaryAssetData(InventoryAssets[RealIndex], AssetData);
 	if (!AssetData.IsValid())
@@ -2237,21 +2806,9 @@ void UInventorySystemComponent::ItemEquipFromInventory_Implementation(const int
 	}
 
 	const FName AssetRegistrySearchablePropertyName = GET_MEMBER_NAME_CHECKED(UItemDataAsset, bCanStack);
-	const FName AssetRegistrySearchableEquipmentTypePropertyName = GET_MEMBER_NAME_CHECKED(UItemEquipmentDataAsset, EquipmentType);
 	AssetData.GetTagValue(AssetRegistrySearchablePropertyName, TempCanStack);
 
-	FAssetDataTagMapSharedView::FFindTagResult TagValue = AssetData.TagsAndValues.FindTag(AssetRegistrySearchableEquipmentTypePropertyName);
-	if (TagValue.IsSet())
-	{
-		TArray<FString> AssetEquipmentTypeStrings{};
-		UE_LOG(InventorySystem, Log, TEXT("[UInventorySystemComponent|%s][ItemEquipFromInventory]: %s"), *GetFName().ToString(), *TagValue.GetValue());
-		FString AssetEquipmentTypeBaseString = ReplaceEquipmentArrayString(TagValue.GetValue());
-		AssetEquipmentTypeBaseString.ParseIntoArray(AssetEquipmentTypeStrings, TEXT(","));
-		for (FString AssetEquipmentTypeString : AssetEquipmentTypeStrings)
-		{
-			AssetEquipmentType.Add(FPrimaryAssetId(AssetEquipmentTypeString));
-		}
-	}
+	const TArray<FPrimaryAssetId> AssetEquipmentType = GetAssetEquipmentTypes(InventoryAssets[RealIndex]);
 
 	if (AssetEquipmentType.IsEmpty())
 	{
@@ -2265,22 +2822,17 @@ void UInventorySystemComponent::ItemEquipFromInventory_Implementation(const int
 	int CreatedEquipmentIndicesIndex = INDEX_NONE;
 	if (EquipmentSlot == INDEX_NONE)
 	{
-		bool bHasValidEquipmentType = false;
-		for (int I = 0; I < EquipmentTypes.Num(); I++)
+		// First slot this item can be equipped to
+		const TArray<int> CompatibleEquipmentSlots = GetCompatibleEquipmentSlots(InventoryAssets[RealIndex]);
+		const bool bHasValidEquipmentType = !CompatibleEquipmentSlots.IsEmpty();
+		if (bHasValidEquipmentType)
 		{
-			// Found first slot this item can be equipped to
-			if (EquipmentTypes[I] != FPrimaryAssetId{} && AssetEquipmentType.Contains(EquipmentTypes[I]))
+			RealEquipmentSlot = CompatibleEquipmentSlots[0];
+			if (!EquipmentIndices.Contains(RealEquipmentSlot))
 			{
-				if (!EquipmentIndices.Contains(EquipmentTypeIndices[I]))
-				{
-					CreatedEquipmentIndicesIndex = EquipmentIndices.AddUnique(EquipmentTypeIndices[I]);
-					EquipmentAmounts.Add(1);
-					EquipmentAssets.Add(FPrimaryAssetId{});
-				}
-
-				RealEquipmentSlot = EquipmentTypeIndices[I];
-				bHasValidEquipmentType = true;
-				break;
+				CreatedEquipmentIndicesIndex = EquipmentIndices.AddUnique(RealEquipmentSlot);
+				EquipmentAmounts.Add(1);
+				EquipmentAssets.Add(FPrimaryAssetId{});
 			}
 		}
 
@@ -2294,8 +2846,8 @@ void UInventorySystemComponent::ItemEquipFromInventory_Implementation(const int
 		}
 	}
 
-	int RealEquipmentIndex = EquipmentIndices.Find(RealEquipmentSlot);
-	const int RealEquipmentTypeIndex = EquipmentTypeIndices.Find(RealEquipmentSlot);
+	int RealEquipmentIndex = FindEquipmentIndex(RealEquipmentSlot);
+	const int RealEquipmentTypeIndex = FindEquipmentTypeIndex(RealEquipmentSlot);
 	TArray ChangedSlots = {Slot};
 	if (RealEquipmentTypeIndex == INDEX_NONE || !EquipmentTypes.IsValidIndex(RealEquipmentTypeIndex) || !EquipmentTypes[RealEquipmentTypeIndex].IsValid() || EquipmentTypes[RealEquipmentTypeIndex] == FPrimaryAssetId() || !InventoryAmounts.IsValidIndex(RealIndex) || !InventoryAssets.IsValidIndex(RealIndex))
 	{
@@ -2326,7 +2878,7 @@ void UInventorySystemComponent::ItemEquipFromInventory_Implementation(const int
 	}
 
 	const int FoundInventoryDynamicStatsIndex = InventoryDynamicStatsIndices.Find(Slot);
-	const int FoundEquipmentDynamicStatsIndex = EquipmentDynamicStatsIndices.Find(RealEquipmentSlot);
+	const int FoundEquipmentDynamicStatsIndex = FindEquipmentDynamicStatsIndex(RealEquipmentSlot);
 
 	if (FoundInventoryDynamicStatsIndex != INDEX_NONE && !InventoryDynamicStats.IsValidIndex(FoundInventoryDynamicStatsIndex))
 	{
@@ -2382,7 +2934,7 @@ void UInventorySystemComponent::ItemEquipFromInventory_Implementation(const int
 						EquipmentAmounts[RealEquipmentIndex] = NewAmount;
 
 						ItemEquipFromInventorySuccessDelegate.Broadcast(true, RealEquipmentSlot, Slot);
-						ChangedEquipmentSlotsDelegate.Broadcast({RealEquipmentSlot});
+						BroadcastChangedEquipmentSlots({RealEquipmentSlot});
 						ChangedInventorySlotsDelegate.Broadcast(ChangedSlots);
 						bIsProcessing = false;
 						return;
@@ -2391,7 +2943,7 @@ void UInventorySystemComponent::ItemEquipFromInventory_Implementation(const int
 					InventoryAmounts[RealIndex] -= GetEquipmentStackSizeConfig() - EquipmentAmounts[RealEquipmentIndex];
 					EquipmentAmounts[RealEquipmentIndex] = FMath::Clamp(NewAmount, 1, GetEquipmentStackSizeConfig());
 					ItemEquipFromInventorySuccessDelegate.Broadcast(true, RealEquipmentSlot, Slot);
-					ChangedEquipmentSlotsDelegate.Broadcast({RealEquipmentSlot});
+					BroadcastChangedEquipmentSlots({RealEquipmentSlot});
 					ChangedInventorySlotsDelegate.Broadcast(ChangedSlots);
 					bIsProcessing = false;
 					return;
@@ -2399,7 +2951,7 @@ void UInventorySystemComponent::ItemEquipFromInventory_Implementation(const int
 				else
 				{
 					ItemEquipFromInventorySuccessDelegate.Broadcast(true, RealEquipmentSlot, Slot);
-					ChangedEquipmentSlotsDelegate.Broadcast({RealEquipmentSlot});
+					BroadcastChangedEquipmentSlots({RealEquipmentSlot});
 					ChangedInventorySlotsDelegate.Broadcast(ChangedSlots);
 					bIsProcessing = false;
 					return;
@@ -2514,7 +3066,7 @@ void UInventorySystemComponent::ItemEquipFromInventory_Implementation(const int
 			}
 
 			ItemEquipFromInventorySuccessDelegate.Broadcast(true, RealEquipmentSlot, Slot);
-			ChangedEquipmentSlotsDelegate.Broadcast({RealEquipmentSlot});
+			BroadcastChangedEquipmentSlots({RealEquipmentSlot});
 			ChangedInventorySlotsDelegate.Broadcast(ChangedSlots);
 			bIsProcessing = false;
 			return;
@@ -2538,7 +3090,7 @@ void UInventorySystemComponent::ItemEquipFromInventory_Implementation(const int
 		}
 
 		ItemEquipFromInventorySuccessDelegate.Broadcast(true, RealEquipmentSlot, Slot);
-		ChangedEquipmentSlotsDelegate.Broadcast({RealEquipmentSlot});
+		BroadcastChangedEquipmentSlots({RealEquipmentSlot});
 		ChangedInventorySlotsDelegate.Broadcast(ChangedSlots);
 		bIsProcessing = false;
 		return;
@@ -2593,7 +3145,7 @@ void UInventorySystemComponent::ItemEquipFromInventory_Implementation(const int
 			}
 
 			ItemEquipFromInventorySuccessDelegate.Broadcast(true, RealEquipmentSlot, Slot);
-			ChangedEquipmentSlotsDelegate.Broadcast({RealEquipmentSlot});
+			BroadcastChangedEquipmentSlots({RealEquipmentSlot});
 			ChangedInventorySlotsDelegate.Broadcast(ChangedSlots);
 			bIsProcessing = false;
 			return;
@@ -2617,7 +3169,7 @@ void UInventorySystemComponent::ItemEquipFromInventory_Implementation(const int
 		}
 
 		ItemEquipFromInventorySuccessDelegate.Broadcast(true, RealEquipmentSlot, Slot);
-		ChangedEquipmentSlotsDelegate.Broadcast({RealEquipmentSlot});
+		BroadcastChangedEquipmentSlots({RealEquipmentSlot});
 		ChangedInventorySlotsDelegate.Broadcast(ChangedSlots);
 		bIsProcessing = false;
 		return;
@@ -2666,14 +3218,14 @@ void UInventorySystemComponent::ItemUnequip_Implementation(const int EquipmentSl
 	}
 	
 	ItemUnequipSuccessDelegate.Broadcast(true, EquipmentSlot, ChangedSlots);
-	ChangedEquipmentSlotsDelegate.Broadcast({EquipmentSlot});
+	BroadcastChangedEquipmentSlots({EquipmentSlot});
 	ChangedInventorySlotsDelegate.Broadcast(ChangedSlots);
 	bIsProcessing = false;
 }
 
 TArray<int> UInventorySystemComponent::ItemUnequipInternal(const int& EquipmentSlot, const TArray<int> IgnoreInventorySlots, const bool bCanStack, const int SpecificInventorySlot)
 {
-	const int RealEquipmentIndex = EquipmentIndices.Find(EquipmentSlot);
+	const int RealEquipmentIndex = FindEquipmentIndex(EquipmentSlot);
 	const UAssetManager* Manager = UAssetManager::GetIfInitialized();
 	if (RealEquipmentIndex == INDEX_NONE || !Manager->IsInitialized() || !EquipmentTypeIndices.Contains(EquipmentSlot) || !EquipmentAssets.IsValidIndex(RealEquipmentIndex) || !EquipmentAmounts.IsValidIndex(RealEquipmentIndex))
 	{
@@ -2693,7 +3245,7 @@ TArray<int> UInventorySystemComponent::ItemUnequipInternal(const int& EquipmentS
 		}
 	}
 
-	const int FoundEquipmentDynamicStatsIndex = EquipmentDynamicStatsIndices.Find(EquipmentSlot);
+	const int FoundEquipmentDynamicStatsIndex = FindEquipmentDynamicStatsIndex(EquipmentSlot);
 	if (FoundEquipmentDynamicStatsIndex != INDEX_NONE && !EquipmentDynamicStats.IsValidIndex(FoundEquipmentDynamicStatsIndex))
 	{
 		UE_LOG(InventorySystem, Error, TEXT("[UInventorySystemComponent|%s][ItemUnequip]: EquipmentDynamicStats is not filled but has an EquipmentDynamicStatsIndices entry"), *GetFName().ToString());
@@ -2917,6 +3469,357 @@ TArray<int> UInventorySystemComponent::ItemUnequipInternal(const int& EquipmentS
 	return ChangedSlots;
 }
 
+bool UInventorySystemComponent::SaveEquipmentLoadout_Validate(const FName LoadoutName)
+{
+	return true;
+}
+
+void UInventorySystemComponent::SaveEquipmentLoadout_Implementation(const FName LoadoutName)
+{
+	if (const AActor* Owner = GetOwner(); !IsValid(Owner) || !Owner->HasAuthority())
+	{
+		UE_LOG(InventorySystem, Error, TEXT("[UInventorySystemComponent|%s][SaveEquipmentLoadout]: Component owner has no authority"), *GetFName().ToString());
+		SaveEquipmentLoadoutSuccessDelegate.Broadcast(false, LoadoutName);
+		return;
+	}
+
+	if (LoadoutName.IsNone())
+	{
+		UE_LOG(InventorySystem, Error, TEXT("[UInventorySystemComponent|%s][SaveEquipmentLoadout]: LoadoutName is required"), *GetFName().ToString());
+		SaveEquipmentLoadoutSuccessDelegate.Broadcast(false, LoadoutName);
+		return;
+	}
+
+	FEquipmentLoadout NewLoadout;
+	NewLoadout.Name = LoadoutName;
+	for (int I = 0; I < EquipmentIndices.Num(); I++)
+	{
+		if (!EquipmentAssets.IsValidIndex(I) || !EquipmentAssets[I].IsValid())
+		{
+			continue;
+		}
+
+		FItemProperties DynamicStats;
+		if (const int RealEquipmentDynamicStatsIndex = FindEquipmentDynamicStatsIndex(EquipmentIndices[I]); EquipmentDynamicStats.IsValidIndex(RealEquipmentDynamicStatsIndex))
+		{
+			DynamicStats = EquipmentDynamicStats[RealEquipmentDynamicStatsIndex];
+		}
+
+		NewLoadout.Entries.Add(FEquipmentLoadoutEntry{EquipmentIndices[I], EquipmentAssets[I], DynamicStats});
+	}
+
+	NewLoadout.Entries.Sort([](const FEquipmentLoadoutEntry& First, const FEquipmentLoadoutEntry& Second)
+	{
+		return First.EquipmentSlot < Second.EquipmentSlot;
+	});
+
+	if (FEquipmentLoadout* ExistingLoadout = EquipmentLoadouts.FindByPredicate([&](const FEquipmentLoadout& Loadout) { return Loadout.Name == LoadoutName; }))
+	{
+		*ExistingLoadout = MoveTemp(NewLoadout);
+	}
+	else
+	{
+		EquipmentLoadouts.Add(MoveTemp(NewLoadout));
+	}
+
+	SaveEquipmentLoadoutSuccessDelegate.Broadcast(true, LoadoutName);
+}
+
+bool UInventorySystemComponent::RemoveEquipmentLoadout_Validate(const FName LoadoutName)
+{
+	return true;
+}
+
+void UInventorySystemComponent::RemoveEquipmentLoadout_Implementation(const FName LoadoutName)
+{
+	if (const AActor* Owner = GetOwner(); !IsValid(Owner) || !Owner->HasAuthority())
+	{
+		UE_LOG(InventorySystem, Error, TEXT("[UInventorySystemComponent|%s][RemoveEquipmentLoadout]: Component owner has no authority"), *GetFName().ToString());
+		RemoveEquipmentLoadoutSuccessDelegate.Broadcast(false, LoadoutName);
+		return;
+	}
+
+	if (EquipmentLoadouts.RemoveAll([&](const FEquipmentLoadout& Loadout) { return Loadout.Name == LoadoutName; }) == 0)
+	{
+		UE_LOG(InventorySystem, Warning, TEXT("[UInventorySystemComponent|%s][RemoveEquipmentLoadout]: Loadout %s not found"), *GetFName().ToString(), *LoadoutName.ToString());
+		RemoveEquipmentLoadoutSuccessDelegate.Broadcast(false, LoadoutName);
+		return;
+	}
+
+	RemoveEquipmentLoadoutSuccessDelegate.Broadcast(true, LoadoutName);
+}
+
+bool UInventorySystemComponent::ApplyEquipmentLoadout_Validate(const FName LoadoutName, const bool bCanStack)
+{
+	return true;
+}
+
+void UInventorySystemComponent::ApplyEquipmentLoadout_Implementation(const FName LoadoutName, const bool bCanStack)
+{
+	const UAssetManager* Manager = UAssetManager::GetIfInitialized();
+	if (!Manager || !Manager->IsInitialized())
+	{
+		UE_LOG(InventorySystem, Error, TEXT("[UInventorySystemComponent|%s][ApplyEquipmentLoadout]: AssetManager is not initialized"), *GetFName().ToString());
+		ApplyEquipmentLoadoutSuccessDelegate.Broadcast(false, LoadoutName, {}, {});
+		return;
+	}
+
+	if (const AActor* Owner = GetOwner(); !IsValid(Owner) || !Owner->HasAuthority())
+	{
+		UE_LOG(InventorySystem, Error, TEXT("[UInventorySystemComponent|%s][ApplyEquipmentLoadout]: Component owner has no authority"), *GetFName().ToString());
+		ApplyEquipmentLoadoutSuccessDelegate.Broadcast(false, LoadoutName, {}, {});
+		return;
+	}
+
+	if (bIsProcessing)
+	{
+		UE_LOG(InventorySystem, Warning, TEXT("[UInventorySystemComponent|%s][ApplyEquipmentLoadout]: Component is still processing previous request"), *GetFName().ToString());
+		ApplyEquipmentLoadoutSuccessDelegate.Broadcast(false, LoadoutName, {}, {});
+		return;
+	}
+
+	bIsProcessing = true;
+
+	const FEquipmentLoadout* Loadout = EquipmentLoadouts.FindByPredicate([&](const FEquipmentLoadout& Other) { return Other.Name == LoadoutName; });
+	if (!Loadout)
+	{
+		UE_LOG(InventorySystem, Warning, TEXT("[UInventorySystemComponent|%s][ApplyEquipmentLoadout]: Loadout %s not found"), *GetFName().ToString(), *LoadoutName.ToString());
+		ApplyEquipmentLoadoutSuccessDelegate.Broadcast(false, LoadoutName, {}, {});
+		bIsProcessing = false;
+		return;
+	}
+
+	// Plan all moves on copies. The component is only changed once the whole plan is valid
+	TArray<FInventorySlot> WorkingInventory = GetInventorySlots();
+	if (WorkingInventory.Num() != InventoryIndices.Num() || EquipmentAssets.Num() != EquipmentIndices.Num() || EquipmentAmounts.Num() != EquipmentIndices.Num())
+	{
+		UE_LOG(InventorySystem, Error, TEXT("[UInventorySystemComponent|%s][ApplyEquipmentLoadout]: Inventory or equipment data is invalid"), *GetFName().ToString());
+		ApplyEquipmentLoadoutSuccessDelegate.Broadcast(false, LoadoutName, {}, {});
+		bIsProcessing = false;
+		return;
+	}
+
+	TMap<int, FInventorySlot> WorkingEquipment;
+	for (int I = 0; I < EquipmentIndices.Num(); I++)
+	{
+		FItemProperties DynamicStats;
+		if (const int RealEquipmentDynamicStatsIndex = FindEquipmentDynamicStatsIndex(EquipmentIndices[I]); EquipmentDynamicStats.IsValidIndex(RealEquipmentDynamicStatsIndex))
+		{
+			DynamicStats = EquipmentDynamicStats[RealEquipmentDynamicStatsIndex];
+		}
+
+		WorkingEquipment.Add(EquipmentIndices[I], FInventorySlot{EquipmentIndices[I], EquipmentAssets[I], DynamicStats, EquipmentAmounts[I]});
+	}
+
+	TMap<FPrimaryAssetId, bool> CanStackByAsset;
+	const std::function CanAssetStack = [&](const FPrimaryAssetId& Asset)
+	{
+		if (const bool* CanStack = CanStackByAsset.Find(Asset))
+		{
+			return *CanStack;
+		}
+
+		bool TempCanStack = false;
+		FAssetData AssetData;
+		Manager->GetPrimaryAssetData(Asset, AssetData);
+		if (AssetData.IsValid())
+		{
+			AssetData.GetTagValue(GET_MEMBER_NAME_CHECKED(UItemDataAsset, bCanStack), TempCanStack);
+		}
+
+		return CanStackByAsset.Add(Asset, TempCanStack);
+	};
+
+	// Collect entries that need a move. Entries already equipped or not fitting the equipment type are skipped
+	TArray<const FEquipmentLoadoutEntry*> PendingEntries;
+	TSet<int> PendingEquipmentSlots;
+	TSet<int> LoadoutEquipmentSlots;
+	for (const FEquipmentLoadoutEntry& Entry : Loadout->Entries)
+	{
+		bool bIsDuplicateSlot = false;
+		LoadoutEquipmentSlots.Add(Entry.EquipmentSlot, &bIsDuplicateSlot);
+		if (bIsDuplicateSlot)
+		{
+			UE_LOG(InventorySystem, Error, TEXT("[UInventorySystemComponent|%s][ApplyEquipmentLoadout]: Loadout %s has more than one entry for equipment slot %d"), *GetFName().ToString(), *LoadoutName.ToString(), Entry.EquipmentSlot);
+			ApplyEquipmentLoadoutSuccessDelegate.Broadcast(false, LoadoutName, {}, {});
+			bIsProcessing = false;
+			return;
+		}
+
+		const int RealEquipmentTypeIndex = FindEquipmentTypeIndex(Entry.EquipmentSlot);
+		if (RealEquipmentTypeIndex == INDEX_NONE || !EquipmentTypes.IsValidIndex(RealEquipmentTypeIndex) || !GetAssetEquipmentTypes(Entry.Asset).Contains(EquipmentTypes[RealEquipmentTypeIndex]))
+		{
+			UE_LOG(InventorySystem, Warning, TEXT("[UInventorySystemComponent|%s][ApplyEquipmentLoadout]: Entry for equipment slot %d does not fit the equipment type. Skipped"), *GetFName().ToString(), Entry.EquipmentSlot);
+			continue;
+		}
+
+		if (const FInventorySlot* Equipped = WorkingEquipment.Find(Entry.EquipmentSlot); Equipped && Equipped->Asset == Entry.Asset && Equipped->ItemProperties == Entry.ItemProperties)
+		{
+			continue;
+		}
+
+		PendingEntries.Add(&Entry);
+		PendingEquipmentSlots.Add(Entry.EquipmentSlot);
+	}
+
+	TArray<FInventorySlot> DisplacedItems;
+	TArray<int> ChangedEquipmentSlots;
+	TSet<int> AssignedEquipmentSlots;
+	for (const FEquipmentLoadoutEntry* Entry : PendingEntries)
+	{
+		const std::function IsLoadoutItem = [&](const FInventorySlot& Item)
+		{
+			return Item.Asset == Entry->Asset && Item.ItemProperties == Entry->ItemProperties;
+		};
+
+		// Search already removed items first, then the inventory, then equipment slots which are replaced by this loadout
+		FInventorySlot NewEquipment;
+		if (const int DisplacedIndex = DisplacedItems.IndexOfByPredicate(IsLoadoutItem); DisplacedIndex != INDEX_NONE)
+		{
+			NewEquipment = DisplacedItems[DisplacedIndex];
+			DisplacedItems.RemoveAt(DisplacedIndex);
+		}
+		else if (const int InventoryIndex = WorkingInventory.IndexOfByPredicate(IsLoadoutItem); InventoryIndex != INDEX_NONE)
+		{
+			FInventorySlot& Source = WorkingInventory[InventoryIndex];
+			const int EquipAmount = bCanStack && CanAssetStack(Source.Asset) ? FMath::Min(Source.Amount, GetEquipmentStackSizeConfig()) : 1;
+			NewEquipment = FInventorySlot{INDEX_NONE, Source.Asset, Source.ItemProperties, EquipAmount};
+			Source.Amount -= EquipAmount;
+			if (Source.Amount <= 0)
+			{
+				WorkingInventory.RemoveAt(InventoryIndex);
+			}
+		}
+		else
+		{
+			int SourceEquipmentSlot = INDEX_NONE;
+			for (const TPair<int, FInventorySlot>& Equipped : WorkingEquipment)
+			{
+				if (Equipped.Key != Entry->EquipmentSlot && PendingEquipmentSlots.Contains(Equipped.Key) && !AssignedEquipmentSlots.Contains(Equipped.Key) && IsLoadoutItem(Equipped.Value))
+				{
+					SourceEquipmentSlot = Equipped.Key;
+					break;
+				}
+			}
+
+			if (SourceEquipmentSlot == INDEX_NONE)
+			{
+				UE_LOG(InventorySystem, Warning, TEXT("[UInventorySystemComponent|%s][ApplyEquipmentLoadout]: Item for equipment slot %d not found"), *GetFName().ToString(), Entry->EquipmentSlot);
+				ApplyEquipmentLoadoutSuccessDelegate.Broadcast(false, LoadoutName, {}, {});
+				bIsProcessing = false;
+				return;
+			}
+
+			WorkingEquipment.RemoveAndCopyValue(SourceEquipmentSlot, NewEquipment);
+			ChangedEquipmentSlots.AddUnique(SourceEquipmentSlot);
+		}
+
+		FInventorySlot ReplacedEquipment;
+		if (WorkingEquipment.RemoveAndCopyValue(Entry->EquipmentSlot, ReplacedEquipment))
+		{
+			DisplacedItems.Add(ReplacedEquipment);
+		}
+
+		NewEquipment.Slot = Entry->EquipmentSlot;
+		WorkingEquipment.Add(Entry->EquipmentSlot, NewEquipment);
+		AssignedEquipmentSlots.Add(Entry->EquipmentSlot);
+		ChangedEquipmentSlots.AddUnique(Entry->EquipmentSlot);
+	}
+
+	// Put replaced items back into the inventory. Fill matching stacks first, then empty slots in order
+	TSet<int> UsedSlots;
+	for (const FInventorySlot& InventorySlot : WorkingInventory)
+	{
+		UsedSlots.Add(InventorySlot.Slot);
+	}
+
+	int NextEmptySlot = 1;
+	const std::function FindEmptySlot = [&]
+	{
+		while (NextEmptySlot <= GetInventorySizeConfig() && UsedSlots.Contains(NextEmptySlot))
+		{
+			NextEmptySlot++;
+		}
+
+		return NextEmptySlot <= GetInventorySizeConfig() ? NextEmptySlot : INDEX_NONE;
+	};
+
+	for (FInventorySlot& DisplacedItem : DisplacedItems)
+	{
+		const bool bStackItem = bCanStack && CanAssetStack(DisplacedItem.Asset);
+		if (bStackItem)
+		{
+			for (FInventorySlot& InventorySlot : WorkingInventory)
+			{
+				if (DisplacedItem.Amount > 0 && InventorySlot.Amount < GetStackSizeConfig() && InventorySlot.Asset == DisplacedItem.Asset && InventorySlot.ItemProperties == DisplacedItem.ItemProperties)
+				{
+					const int AddedAmount = FMath::Min(DisplacedItem.Amount, GetStackSizeConfig() - InventorySlot.Amount);
+					InventorySlot.Amount += AddedAmount;
+					DisplacedItem.Amount -= AddedAmount;
+				}
+			}
+		}
+
+		while (DisplacedItem.Amount > 0)
+		{
+			const int EmptySlot = FindEmptySlot();
+			if (EmptySlot == INDEX_NONE)
+			{
+				UE_LOG(InventorySystem, Warning, TEXT("[UInventorySystemComponent|%s][ApplyEquipmentLoadout]: Not enough space in inventory for the replaced items"), *GetFName().ToString());
+				ApplyEquipmentLoadoutSuccessDelegate.Broadcast(false, LoadoutName, {}, {});
+				bIsProcessing = false;
+				return;
+			}
+
+			const int AddedAmount = bStackItem ? FMath::Min(DisplacedItem.Amount, GetStackSizeConfig()) : 1;
+			WorkingInventory.Add(FInventorySlot{EmptySlot, DisplacedItem.Asset, DisplacedItem.ItemProperties, AddedAmount});
+			UsedSlots.Add(EmptySlot);
+			DisplacedItem.Amount -= AddedAmount;
+		}
+	}
+
+	// Apply the plan
+	const TArray<int> ChangedSlots = ApplyInventorySlots(WorkingInventory);
+	for (const int EquipmentSlot : ChangedEquipmentSlots)
+	{
+		if (const int RealEquipmentIndex = FindEquipmentIndex(EquipmentSlot); RealEquipmentIndex != INDEX_NONE)
+		{
+			EquipmentIndices.RemoveAt(RealEquipmentIndex);
+			EquipmentAssets.RemoveAt(RealEquipmentIndex);
+			EquipmentAmounts.RemoveAt(RealEquipmentIndex);
+		}
+
+		if (const int RealEquipmentDynamicStatsIndex = FindEquipmentDynamicStatsIndex(EquipmentSlot); RealEquipmentDynamicStatsIndex != INDEX_NONE)
+		{
+			EquipmentDynamicStatsIndices.RemoveAt(RealEquipmentDynamicStatsIndex);
+			EquipmentDynamicStats.RemoveAt(RealEquipmentDynamicStatsIndex);
+		}
+
+		if (const FInventorySlot* NewEquipment = WorkingEquipment.Find(EquipmentSlot))
+		{
+			EquipmentIndices.Add(EquipmentSlot);
+			EquipmentAssets.Add(NewEquipment->Asset);
+			EquipmentAmounts.Add(NewEquipment->Amount);
+			if (!NewEquipment->ItemProperties.ItemProperties.IsEmpty())
+			{
+				EquipmentDynamicStatsIndices.Add(EquipmentSlot);
+				EquipmentDynamicStats.Add(NewEquipment->ItemProperties);
+			}
+		}
+	}
+
+	ApplyEquipmentLoadoutSuccessDelegate.Broadcast(true, LoadoutName, ChangedEquipmentSlots, ChangedSlots);
+	if (!ChangedEquipmentSlots.IsEmpty())
+	{
+		BroadcastChangedEquipmentSlots(ChangedEquipmentSlots);
+	}
+	if (!ChangedSlots.IsEmpty())
+	{
+		ChangedInventorySlotsDelegate.Broadcast(ChangedSlots);
+	}
+	bIsProcessing = false;
+}
+
 TArray<int> UInventorySystemComponent::AddItemToComponentInternal(const int Slot, UItemContainerComponent* ItemContainerComponent, int& Amount, const bool bCanStack, const bool bIsEquipment, const bool bRevertWhenFull)
 {
 	if (!bIsEquipment)
@@ -2924,7 +3827,7 @@ TArray<int> UInventorySystemComponent::AddItemToComponentInternal(const int Slot
 		return Super::AddItemToComponentInternal(Slot, ItemContainerComponent, Amount, bCanStack, bIsEquipment, bRevertWhenFull);	
 	}
 
-	const int Index = EquipmentIndices.Find(Slot);
+	const int Index = FindEquipmentIndex(Slot);
 	TArray<int> ChangedSlots;
 	if (Amount <= 0 || Index == INDEX_NONE || !EquipmentAssets.IsValidIndex(Index) || !EquipmentAssets[Index].IsValid() || EquipmentAssets[Index] == FPrimaryAssetId() || !EquipmentAmounts.IsValidIndex(Index) || EquipmentAmounts[Index] <= 0 || Amount > EquipmentAmounts[Index])
 	{
@@ -2939,7 +3842,7 @@ TArray<int> UInventorySystemComponent::AddItemToComponentInternal(const int Slot
 	}
 
 	FItemProperties DynamicStats{};
-	const int RealEquipmentDynamicStatsIndicesIndex = EquipmentDynamicStatsIndices.Find(Slot);
+	const int RealEquipmentDynamicStatsIndicesIndex = FindEquipmentDynamicStatsIndex(Slot);
 	if (RealEquipmentDynamicStatsIndicesIndex != INDEX_NONE)
 	{
 		if (!EquipmentDynamicStats.IsValidIndex(RealEquipmentDynamicStatsIndicesIndex))
@@ -3015,7 +3918,7 @@ void UInventorySystemComponent::CollectAllItems_Implementation(UItemContainerCom
 	TArray<int> ChangedSlotsOtherComponent;
 	const std::function<bool(int, int)> AddEquipmentItemToComponent = [&](const int Slot, const int Amount)
 	{
-		const int Index = EquipmentIndices.Find(Slot);
+		const int Index = FindEquipmentIndex(Slot);
 		if (Amount <= 0 || Index == INDEX_NONE || !EquipmentAssets.IsValidIndex(Index) || !EquipmentAssets[Index].IsValid() || EquipmentAssets[Index] == FPrimaryAssetId() || !EquipmentAmounts.IsValidIndex(Index) || EquipmentAmounts[Index]<= 0 || Amount > EquipmentAmounts[Index])
 		{
 			UE_LOG(InventorySystem, Error, TEXT("[UInventorySystemComponent|%s][CollectAllItems]: Data invalid for slot %d"), *GetFName().ToString(), Slot);
@@ -3024,7 +3927,7 @@ void UInventorySystemComponent::CollectAllItems_Implementation(UItemContainerCom
 		}
 
 		FItemProperties DynamicStats{};
-		const int RealEquipmentDynamicStatsIndicesIndex = EquipmentDynamicStatsIndices.Find(Slot);
+		const int RealEquipmentDynamicStatsIndicesIndex = FindEquipmentDynamicStatsIndex(Slot);
 		if (RealEquipmentDynamicStatsIndicesIndex != INDEX_NONE)
 		{
 			if (!EquipmentDynamicStats.IsValidIndex(RealEquipmentDynamicStatsIndicesIndex))
@@ -3116,7 +4019,7 @@ void UInventorySystemComponent::CollectAllItems_Implementation(UItemContainerCom
 	CollectAllItemsSuccessDelegate.Broadcast(bAddedOnce, bItemsLeft, ItemContainerComponent);
 	ItemContainerComponent->CollectAllItemsOtherComponentSuccessDelegate.Broadcast(bAddedOnce, bItemsLeft, this);
 	ChangedInventorySlotsDelegate.Broadcast(ChangedSlots);
-	ChangedEquipmentSlotsDelegate.Broadcast(ChangedEquipmentSlots);
+	BroadcastChangedEquipmentSlots(ChangedEquipmentSlots);
 	ItemContainerComponent->ChangedInventorySlotsDelegate.Broadcast(ChangedSlotsOtherComponent);
 	ItemContainerComponent->bIsProcessing = false;
 	bIsProcessing = false;
@@ -3149,7 +4052,7 @@ void UInventorySystemComponent::SetEquipmentStackSizeConfig_Implementation(const
 		MaxEquipmentStackSize = NewMaxEquipmentStackSize;
 		InternalChecks();
 		SetMaxEquipmentStackSizeSuccessDelegate.Broadcast(true);
-		ChangedEquipmentSlotsDelegate.Broadcast(EquipmentTypeIndices);
+		BroadcastChangedEquipmentSlots(EquipmentTypeIndices);
 		bIsProcessing = false;
 		return;
 	}
@@ -3170,7 +4073,7 @@ void UInventorySystemComponent::SetEquipmentStackSizeConfig_Implementation(const
 
 	MaxEquipmentStackSize = NewMaxEquipmentStackSize;
 	SetMaxEquipmentStackSizeSuccessDelegate.Broadcast(true);
-	ChangedEquipmentSlotsDelegate.Broadcast(EquipmentTypeIndices);
+	BroadcastChangedEquipmentSlots(EquipmentTypeIndices);
 	bIsProcessing = false;
 }
 
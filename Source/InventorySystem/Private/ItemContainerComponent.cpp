@@ -12,10 +12,14 @@
 #include "Settings/InventorySystemSettings.h"
 #include "UObject/ObjectSaveContext.h"
 #include "Kismet/KismetMathLibrary.h"
+#include "Algo/BinarySearch.h"
+#include "Algo/Reverse.h"
 #include "UObject/SavePackage.h"
 
 #define LOCTEXT_NAMESPACE "InventorySystem"
 
+FItemContainerComponentReadyDelegate UItemContainerComponent::ItemContainerComponentReadyDelegate;
+
 UItemContainerComponent::UItemContainerComponent()
 {
 #if WITH_EDITORONLY_DATA
@@ -161,23 +165,15 @@ void UItemContainerComponent::OnRep_InventoryDynamicStatsIndices(TArray<int> Old
 
 void UItemContainerComponent::OnRep_InventoryDynamicStats(TArray<FItemProperties> OldInventoryDynamicStats)
 {
-	// Check for changes in the array
+	// Check for changes in the array. Index is the position in InventoryDynamicStatsIndices, not the slot
 	for (int Index = 0; Index < InventoryDynamicStats.Num(); Index++)
 	{
-		if (!OldInventoryDynamicStats.IsValidIndex(Index))
-		{
-			continue;
-		}
-		
-		if (const int* RealInventoryDynamicStatsSlot = InventoryDynamicStatsIndices.FindByKey(Index); RealInventoryDynamicStatsSlot != nullptr)
+		if (InventoryDynamicStatsIndices.IsValidIndex(Index))
 		{
-			if (const int RealInventoryIndex = InventoryIndices.Find(*RealInventoryDynamicStatsSlot); RealInventoryIndex != INDEX_NONE)
+			// Check if index was added or changed
+			if (!OldInventoryDynamicStats.IsValidIndex(Index) || InventoryDynamicStats[Index] != OldInventoryDynamicStats[Index])
 			{
-				// Check if value added or changed
-				if (InventoryDynamicStats[Index] != OldInventoryDynamicStats[Index])
-				{
-					ChangedInventorySlotsDelegate.Broadcast({InventoryIndices[RealInventoryIndex]});
-				}		
+				ChangedInventorySlotsDelegate.Broadcast({InventoryDynamicStatsIndices[Index]});
 			}
 		}
 	}
@@ -652,11 +648,18 @@ void UItemContainerComponent::BeginPlay()
 		return;
 	}
 
+	// Keep the query indexes in sync with every change on server and client
+	ChangedInventorySlotsDelegate.AddDynamic(this, &UItemContainerComponent::UpdateQueryIndex);
+	RebuildQueryIndex();
+
+	ChangedInventorySlotsDelegate.AddDynamic(this, &UItemContainerComponent::DispatchInventorySlotSubscriptions);
+
 #if WITH_EDITORONLY_DATA
 	InventoryDataAssets.Empty();
 #endif
 
 	bIsProcessing = false;
+	ItemContainerComponentReadyDelegate.Broadcast(this);
 }
 
 TArray<FInventorySlot> UItemContainerComponent::GetInventorySlots() const
@@ -666,17 +669,32 @@ TArray<FInventorySlot> UItemContainerComponent::GetInventorySlots() const
 		return {};
 	}
 
-	TArray<FInventorySlot> InventorySlots;
-	for (const int Slot: InventoryIndices)
+	if (InventoryAmounts.Num() != InventoryIndices.Num() || InventoryAssets.Num() != InventoryIndices.Num())
+	{
+		UE_LOG(InventorySystem, Error, TEXT("[UItemContainerComponent|%s][GetInventorySlots]: Inventory arrays are not aligned"), *GetFName().ToString());
+		return {};
+	}
+
+	// Resolve dynamic stats once per slot instead of searching the indices for every item
+	TMap<int, int> DynamicStatsIndicesBySlot;
+	DynamicStatsIndicesBySlot.Reserve(InventoryDynamicStatsIndices.Num());
+	for (int I = 0; I < InventoryDynamicStatsIndices.Num(); I++)
 	{
-		if (FInventorySlot NewSlot = GetInventorySlot(Slot); NewSlot.Slot != INDEX_NONE)
+		if (!InventoryDynamicStats.IsValidIndex(I))
 		{
-			InventorySlots.Add(NewSlot);
-			continue;
+			UE_LOG(InventorySystem, Error, TEXT("[UItemContainerComponent|%s][GetInventorySlots]: InventoryDynamicStats is not filled but has an InventoryDynamicStatsIndices entry"), *GetFName().ToString());
+			return {};
 		}
 
-		InventorySlots.Empty();
-		break;
+		DynamicStatsIndicesBySlot.Add(InventoryDynamicStatsIndices[I], I);
+	}
+
+	TArray<FInventorySlot> InventorySlots;
+	InventorySlots.Reserve(InventoryIndices.Num());
+	for (int I = 0; I < InventoryIndices.Num(); I++)
+	{
+		const int* DynamicStatsIndex = DynamicStatsIndicesBySlot.Find(InventoryIndices[I]);
+		InventorySlots.Add(FInventorySlot{InventoryIndices[I], InventoryAssets[I], DynamicStatsIndex ? InventoryDynamicStats[*DynamicStatsIndex] : FItemProperties{}, InventoryAmounts[I]});
 	}
 
 	return InventorySlots;
@@ -753,6 +771,342 @@ FItemProperty UItemContainerComponent::GetItemProperty(const int Slot, const FNa
 	return {};
 }
 
+TArray<int> UItemContainerComponent::QueryInventorySlots(const FItemContainerQuery& Query)
+{
+	// Safety net for changes that were not broadcast
+	if (QueryIndexEntries.Num() != InventoryIndices.Num())
+	{
+		RebuildQueryIndex();
+	}
+
+	// Start with the smallest candidate set and check the remaining filters per slot
+	static const TSet<int> EmptySlots;
+	const TSet<int>* Candidates = nullptr;
+	const auto NarrowCandidates = [&Candidates](const TSet<int>* Slots)
+	{
+		const TSet<int>* FoundSlots = Slots ? Slots : &EmptySlots;
+		if (!Candidates || FoundSlots->Num() < Candidates->Num())
+		{
+			Candidates = FoundSlots;
+		}
+	};
+
+	if (Query.Asset.IsValid())
+	{
+		NarrowCandidates(QueryIndexSlotsByAsset.Find(Query.Asset));
+	}
+
+	if (Query.AssetType.IsValid())
+	{
+		NarrowCandidates(QueryIndexSlotsByAssetType.Find(Query.AssetType));
+	}
+
+	if (!Query.PropertyName.IsNone())
+	{
+		NarrowCandidates(QueryIndexSlotsByProperty.Find(Query.PropertyName));
+	}
+
+	const TMap<int, double>* NumericValues = Query.bUseValueRange ? QueryIndexNumericValues.Find(Query.PropertyName) : nullptr;
+	if (Query.bUseValueRange && !NumericValues)
+	{
+		return {};
+	}
+
+	// Sorted properties can narrow the candidates to the value range directly
+	TArray<int> RangeSlots;
+	const bool bUseRangeSlots = Query.bUseValueRange && QueryIndexSortedValues.Contains(Query.PropertyName);
+	if (bUseRangeSlots)
+	{
+		RangeSlots = GetSlotsInPropertyRange(Query.PropertyName, Query.MinValue, Query.MaxValue);
+	}
+
+	TArray<int> Slots;
+	const auto MatchesSlot = [&](const int Slot)
+	{
+		const TPair<FPrimaryAssetId, TArray<FName>>* Entry = QueryIndexEntries.Find(Slot);
+		if (!Entry)
+		{
+			return false;
+		}
+
+		if ((Query.Asset.IsValid() && Entry->Key != Query.Asset) || (Query.AssetType.IsValid() && Entry->Key.PrimaryAssetType != Query.AssetType) || (!Query.PropertyName.IsNone() && !Entry->Value.Contains(Query.PropertyName)))
+		{
+			return false;
+		}
+
+		if (NumericValues)
+		{
+			const double* Value = NumericValues->Find(Slot);
+			return Value && *Value >= Query.MinValue && *Value <= Query.MaxValue;
+		}
+
+		return true;
+	};
+
+	if (bUseRangeSlots && (!Candidates || RangeSlots.Num() < Candidates->Num()))
+	{
+		for (const int Slot : RangeSlots)
+		{
+			if (MatchesSlot(Slot))
+			{
+				Slots.Add(Slot);
+			}
+		}
+	}
+	else if (Candidates)
+	{
+		for (const int Slot : *Candidates)
+		{
+			if (MatchesSlot(Slot))
+			{
+				Slots.Add(Slot);
+			}
+		}
+	}
+	else
+	{
+		QueryIndexEntries.GenerateKeyArray(Slots);
+	}
+
+	Slots.Sort();
+	return Slots;
+}
+
+TArray<int> UItemContainerComponent::GetSlotsInPropertyRange(const FName PropertyName, const double MinValue, const double MaxValue)
+{
+	if (QueryIndexEntries.Num() != InventoryIndices.Num())
+	{
+		RebuildQueryIndex();
+	}
+
+	TArray<int> Slots;
+	if (const TArray<TPair<double, int>>* SortedValues = QueryIndexSortedValues.Find(PropertyName))
+	{
+		const int Start = Algo::LowerBound(*SortedValues, TPair<double, int>(MinValue, MIN_int32));
+		for (int I = Start; I < SortedValues->Num() && (*SortedValues)[I].Key <= MaxValue; I++)
+		{
+			Slots.Add((*SortedValues)[I].Value);
+		}
+
+		return Slots;
+	}
+
+	UE_LOG(InventorySystem, Verbose, TEXT("[UItemContainerComponent|%s][GetSlotsInPropertyRange]: Property %s is not indexed. Add it to IndexedPropertyNames in the settings for faster range queries"), *GetFName().ToString(), *PropertyName.ToString());
+	const TMap<int, double>* NumericValues = QueryIndexNumericValues.Find(PropertyName);
+	if (!NumericValues)
+	{
+		return Slots;
+	}
+
+	TArray<TPair<double, int>> Values;
+	for (const TPair<int, double>& Pair : *NumericValues)
+	{
+		if (Pair.Value >= MinValue && Pair.Value <= MaxValue)
+		{
+			Values.Add(TPair<double, int>(Pair.Value, Pair.Key));
+		}
+	}
+
+	Values.Sort();
+	for (const TPair<double, int>& Value : Values)
+	{
+		Slots.Add(Value.Value);
+	}
+
+	return Slots;
+}
+
+TArray<int> UItemContainerComponent::GetTopSlotsByProperty(const FName PropertyName, const int Count, const bool bHighest)
+{
+	if (Count <= 0)
+	{
+		return {};
+	}
+
+	if (QueryIndexEntries.Num() != InventoryIndices.Num())
+	{
+		RebuildQueryIndex();
+	}
+
+	TArray<int> Slots;
+	if (const TArray<TPair<double, int>>* SortedValues = QueryIndexSortedValues.Find(PropertyName))
+	{
+		const int ResultCount = FMath::Min(Count, SortedValues->Num());
+		for (int I = 0; I < ResultCount; I++)
+		{
+			Slots.Add((*SortedValues)[bHighest ? SortedValues->Num() - 1 - I : I].Value);
+		}
+
+		return Slots;
+	}
+
+	UE_LOG(InventorySystem, Verbose, TEXT("[UItemContainerComponent|%s][GetTopSlotsByProperty]: Property %s is not indexed. Add it to IndexedPropertyNames in the settings for faster top-k queries"), *GetFName().ToString(), *PropertyName.ToString());
+	TArray<int> RangeSlots = GetSlotsInPropertyRange(PropertyName, TNumericLimits<double>::Lowest(), TNumericLimits<double>::Max());
+	if (bHighest)
+	{
+		Algo::Reverse(RangeSlots);
+	}
+
+	RangeSlots.SetNum(FMath::Min(Count, RangeSlots.Num()));
+	return RangeSlots;
+}
+
+FDelegateHandle UItemContainerComponent::SubscribeInventorySlot(const int Slot, FSlotSubscriptionDelegate::FDelegate&& Delegate)
+{
+	return InventorySlotSubscriptions.FindOrAdd(Slot).Add(MoveTemp(Delegate));
+}
+
+void UItemContainerComponent::UnsubscribeInventorySlot(const int Slot, const FDelegateHandle& Handle)
+{
+	if (FSlotSubscriptionDelegate* Subscribers = InventorySlotSubscriptions.Find(Slot))
+	{
+		// Keep the entry. Removing it could destroy a delegate that is currently broadcasting
+		Subscribers->Remove(Handle);
+	}
+}
+
+void UItemContainerComponent::DispatchInventorySlotSubscriptions(const TArray<int>& Slots)
+{
+	if (InventorySlotSubscriptions.IsEmpty())
+	{
+		return;
+	}
+
+	for (const int Slot : Slots)
+	{
+		// Broadcast a copy. Subscribers may subscribe other slots and reallocate the map
+		if (const FSlotSubscriptionDelegate* Subscribers = InventorySlotSubscriptions.Find(Slot))
+		{
+			const FSlotSubscriptionDelegate SubscribersCopy = *Subscribers;
+			SubscribersCopy.Broadcast(Slot);
+		}
+	}
+}
+
+void UItemContainerComponent::UpdateQueryIndex(const TArray<int>& Slots)
+{
+	// Large changes (sorting, collecting) are cheaper to rebuild in one pass
+	if (Slots.Num() * 4 > InventoryIndices.Num())
+	{
+		RebuildQueryIndex();
+		return;
+	}
+
+	for (const int Slot : Slots)
+	{
+		RemoveSlotFromQueryIndex(Slot);
+
+		const int RealInventoryIndex = InventoryIndices.Find(Slot);
+		if (RealInventoryIndex == INDEX_NONE || !InventoryAssets.IsValidIndex(RealInventoryIndex))
+		{
+			continue;
+		}
+
+		const int RealInventoryDynamicStatsIndex = InventoryDynamicStatsIndices.Find(Slot);
+		AddSlotToQueryIndex(Slot, InventoryAssets[RealInventoryIndex], InventoryDynamicStats.IsValidIndex(RealInventoryDynamicStatsIndex) ? InventoryDynamicStats[RealInventoryDynamicStatsIndex] : FItemProperties{});
+	}
+}
+
+void UItemContainerComponent::RebuildQueryIndex()
+{
+	QueryIndexSlotsByAsset.Reset();
+	QueryIndexSlotsByAssetType.Reset();
+	QueryIndexSlotsByProperty.Reset();
+	QueryIndexNumericValues.Reset();
+	QueryIndexSortedValues.Reset();
+	QueryIndexEntries.Reset();
+
+	const UInventorySystemSettings* InventorySettings = GetMutableDefault<UInventorySystemSettings>();
+	for (const FName& PropertyName : InventorySettings->IndexedPropertyNames)
+	{
+		QueryIndexSortedValues.Add(PropertyName);
+	}
+
+	TMap<int, int> DynamicStatsIndicesBySlot;
+	DynamicStatsIndicesBySlot.Reserve(InventoryDynamicStatsIndices.Num());
+	for (int I = 0; I < InventoryDynamicStatsIndices.Num(); I++)
+	{
+		DynamicStatsIndicesBySlot.Add(InventoryDynamicStatsIndices[I], I);
+	}
+
+	for (int I = 0; I < InventoryIndices.Num() && I < InventoryAssets.Num(); I++)
+	{
+		const int* DynamicStatsIndex = DynamicStatsIndicesBySlot.Find(InventoryIndices[I]);
+		AddSlotToQueryIndex(InventoryIndices[I], InventoryAssets[I], DynamicStatsIndex && InventoryDynamicStats.IsValidIndex(*DynamicStatsIndex) ? InventoryDynamicStats[*DynamicStatsIndex] : FItemProperties{});
+	}
+}
+
+void UItemContainerComponent::RemoveSlotFromQueryIndex(const int Slot)
+{
+	TPair<FPrimaryAssetId, TArray<FName>> Entry;
+	if (!QueryIndexEntries.RemoveAndCopyValue(Slot, Entry))
+	{
+		return;
+	}
+
+	if (TSet<int>* Slots = QueryIndexSlotsByAsset.Find(Entry.Key))
+	{
+		Slots->Remove(Slot);
+	}
+
+	if (TSet<int>* Slots = QueryIndexSlotsByAssetType.Find(Entry.Key.PrimaryAssetType))
+	{
+		Slots->Remove(Slot);
+	}
+
+	for (const FName& PropertyName : Entry.Value)
+	{
+		if (TSet<int>* Slots = QueryIndexSlotsByProperty.Find(PropertyName))
+		{
+			Slots->Remove(Slot);
+		}
+
+		if (TMap<int, double>* NumericValues = QueryIndexNumericValues.Find(PropertyName))
+		{
+			double Value = 0.0;
+			if (NumericValues->RemoveAndCopyValue(Slot, Value))
+			{
+				if (TArray<TPair<double, int>>* SortedValues = QueryIndexSortedValues.Find(PropertyName))
+				{
+					if (const int SortedIndex = Algo::BinarySearch(*SortedValues, TPair<double, int>(Value, Slot)); SortedIndex != INDEX_NONE)
+					{
+						SortedValues->RemoveAt(SortedIndex);
+					}
+				}
+			}
+		}
+	}
+}
+
+void UItemContainerComponent::AddSlotToQueryIndex(const int Slot, const FPrimaryAssetId& Asset, const FItemProperties& DynamicStats)
+{
+	TPair<FPrimaryAssetId, TArray<FName>>& Entry = QueryIndexEntries.Add(Slot);
+	Entry.Key = Asset;
+	QueryIndexSlotsByAsset.FindOrAdd(Asset).Add(Slot);
+	QueryIndexSlotsByAssetType.FindOrAdd(Asset.PrimaryAssetType).Add(Slot);
+
+	for (const FItemProperty& ItemProperty : DynamicStats.ItemProperties)
+	{
+		if (ItemProperty.Name.IsNone() || Entry.Value.Contains(ItemProperty.Name))
+		{
+			continue;
+		}
+
+		Entry.Value.Add(ItemProperty.Name);
+		QueryIndexSlotsByProperty.FindOrAdd(ItemProperty.Name).Add(Slot);
+		if (ItemProperty.Value.IsNumeric())
+		{
+			const double Value = FCString::Atod(*ItemProperty.Value.ToString());
+			QueryIndexNumericValues.FindOrAdd(ItemProperty.Name).Add(Slot, Value);
+			if (TArray<TPair<double, int>>* SortedValues = QueryIndexSortedValues.Find(ItemProperty.Name))
+			{
+				const TPair<double, int> SortedValue(Value, Slot);
+				SortedValues->Insert(SortedValue, Algo::LowerBound(*SortedValues, SortedValue));
+			}
+		}
+	}
+}
+
 bool UItemContainerComponent::SetSlotAmount_Validate(const int Slot, const int Amount, const bool bIsEquipment)
 {
 	return true;
@@ -2287,6 +2641,481 @@ void UItemContainerComponent::CollectAllItems_Implementation(UItemContainerCompo
 	ItemContainerComponent->bIsProcessing = false;
 }
 
+bool UItemContainerComponent::SortItems_Validate(const EItemContainerSortKey SortKey, const FName PropertyName, const bool bDescending, const bool bRestack)
+{
+	return true;
+}
+
+void UItemContainerComponent::SortItems_Implementation(const EItemContainerSortKey SortKey, const FName PropertyName, const bool bDescending, const bool bRestack)
+{
+	if (bIsProcessing)
+	{
+		UE_LOG(InventorySystem, Warning, TEXT("[UItemContainerComponent|%s][SortItems]: Component is still processing previous request"), *GetFName().ToString());
+		SortItemsSuccessDelegate.Broadcast(false, {});
+		return;
+	}
+
+	bIsProcessing = true;
+
+	if (SortKey == EItemContainerSortKey::PropertyValue && PropertyName.IsNone())
+	{
+		UE_LOG(InventorySystem, Error, TEXT("[UItemContainerComponent|%s][SortItems]: PropertyName is required to sort by property value"), *GetFName().ToString());
+		SortItemsSuccessDelegate.Broadcast(false, {});
+		bIsProcessing = false;
+		return;
+	}
+
+	TArray<FInventorySlot> InventorySlots = GetInventorySlots();
+	if (InventorySlots.Num() != InventoryIndices.Num())
+	{
+		UE_LOG(InventorySystem, Error, TEXT("[UItemContainerComponent|%s][SortItems]: Inventory data is invalid"), *GetFName().ToString());
+		SortItemsSuccessDelegate.Broadcast(false, {});
+		bIsProcessing = false;
+		return;
+	}
+
+	if (bRestack && !ConsolidateInventorySlots(InventorySlots))
+	{
+		SortItemsSuccessDelegate.Broadcast(false, {});
+		bIsProcessing = false;
+		return;
+	}
+
+	// Precompute the keys once so the comparator does not convert texts for every comparison
+	struct FSortEntry
+	{
+		int Index = INDEX_NONE;
+		FString AssetName;
+		bool bHasProperty = false;
+		bool bIsNumeric = false;
+		double NumericValue = 0.0;
+		FString TextValue;
+	};
+
+	TArray<FSortEntry> SortEntries;
+	SortEntries.Reserve(InventorySlots.Num());
+	for (int I = 0; I < InventorySlots.Num(); I++)
+	{
+		FSortEntry& SortEntry = SortEntries.AddDefaulted_GetRef();
+		SortEntry.Index = I;
+		SortEntry.AssetName = InventorySlots[I].Asset.ToString();
+
+		if (SortKey != EItemContainerSortKey::PropertyValue)
+		{
+			continue;
+		}
+
+		for (const FItemProperty& ItemProperty : InventorySlots[I].ItemProperties.ItemProperties)
+		{
+			if (ItemProperty.Name == PropertyName)
+			{
+				SortEntry.bHasProperty = true;
+				SortEntry.bIsNumeric = ItemProperty.Value.IsNumeric();
+				SortEntry.TextValue = ItemProperty.Value.ToString();
+				SortEntry.NumericValue = SortEntry.bIsNumeric ? FCString::Atod(*SortEntry.TextValue) : 0.0;
+				break;
+			}
+		}
+	}
+
+	SortEntries.Sort([&](const FSortEntry& First, const FSortEntry& Second)
+	{
+		const FInventorySlot& FirstSlot = InventorySlots[First.Index];
+		const FInventorySlot& SecondSlot = InventorySlots[Second.Index];
+
+		int Result = 0;
+		switch (SortKey)
+		{
+		case EItemContainerSortKey::PropertyValue:
+			// Items without the property are always placed last, numeric values before text values
+			if (First.bHasProperty != Second.bHasProperty)
+			{
+				return First.bHasProperty;
+			}
+
+			if (First.bIsNumeric != Second.bIsNumeric)
+			{
+				return First.bIsNumeric;
+			}
+
+			if (First.bIsNumeric)
+			{
+				Result = First.NumericValue < Second.NumericValue ? -1 : (First.NumericValue > Second.NumericValue ? 1 : 0);
+			}
+			else
+			{
+				Result = First.TextValue.Compare(Second.TextValue);
+			}
+			break;
+		case EItemContainerSortKey::Amount:
+			Result = FirstSlot.Amount - SecondSlot.Amount;
+			break;
+		default:
+			Result = First.AssetName.Compare(Second.AssetName);
+			break;
+		}
+
+		if (Result != 0)
+		{
+			return bDescending ? Result > 0 : Result < 0;
+		}
+
+		// Tie breakers keep the order deterministic: asset, bigger stacks first, previous slot
+		if (const int AssetResult = First.AssetName.Compare(Second.AssetName); AssetResult != 0)
+		{
+			return AssetResult < 0;
+		}
+
+		if (FirstSlot.Amount != SecondSlot.Amount)
+		{
+			return FirstSlot.Amount > SecondSlot.Amount;
+		}
+
+		return FirstSlot.Slot < SecondSlot.Slot;
+	});
+
+	// Compact into slots 1..N in sorted order
+	TArray<FInventorySlot> NewInventorySlots;
+	NewInventorySlots.Reserve(SortEntries.Num());
+	for (int I = 0; I < SortEntries.Num(); I++)
+	{
+		FInventorySlot& NewInventorySlot = NewInventorySlots.Add_GetRef(InventorySlots[SortEntries[I].Index]);
+		NewInventorySlot.Slot = I + 1;
+	}
+
+	const TArray<int> ChangedSlots = ApplyInventorySlots(NewInventorySlots);
+	SortItemsSuccessDelegate.Broadcast(true, ChangedSlots);
+	if (!ChangedSlots.IsEmpty())
+	{
+		ChangedInventorySlotsDelegate.Broadcast(ChangedSlots);
+	}
+	bIsProcessing = false;
+}
+
+bool UItemContainerComponent::ConsolidateStacks_Validate()
+{
+	return true;
+}
+
+void UItemContainerComponent::ConsolidateStacks_Implementation()
+{
+	if (bIsProcessing)
+	{
+		UE_LOG(InventorySystem, Warning, TEXT("[UItemContainerComponent|%s][ConsolidateStacks]: Component is still processing previous request"), *GetFName().ToString());
+		ConsolidateStacksSuccessDelegate.Broadcast(false, {});
+		return;
+	}
+
+	bIsProcessing = true;
+
+	TArray<FInventorySlot> InventorySlots = GetInventorySlots();
+	if (InventorySlots.Num() != InventoryIndices.Num())
+	{
+		UE_LOG(InventorySystem, Error, TEXT("[UItemContainerComponent|%s][ConsolidateStacks]: Inventory data is invalid"), *GetFName().ToString());
+		ConsolidateStacksSuccessDelegate.Broadcast(false, {});
+		bIsProcessing = false;
+		return;
+	}
+
+	if (!ConsolidateInventorySlots(InventorySlots))
+	{
+		ConsolidateStacksSuccessDelegate.Broadcast(false, {});
+		bIsProcessing = false;
+		return;
+	}
+
+	const TArray<int> ChangedSlots = ApplyInventorySlots(InventorySlots);
+	ConsolidateStacksSuccessDelegate.Broadcast(true, ChangedSlots);
+	if (!ChangedSlots.IsEmpty())
+	{
+		ChangedInventorySlotsDelegate.Broadcast(ChangedSlots);
+	}
+	bIsProcessing = false;
+}
+
+bool UItemContainerComponent::ConsolidateInventorySlots(TArray<FInventorySlot>& InventorySlots) const
+{
+	const UAssetManager* Manager = UAssetManager::GetIfInitialized();
+	if (!Manager || !Manager->IsInitialized())
+	{
+		UE_LOG(InventorySystem, Error, TEXT("[UItemContainerComponent|%s][ConsolidateInventorySlots]: AssetManager is not initialized"), *GetFName().ToString());
+		return false;
+	}
+
+	// Fill stacks front to back
+	InventorySlots.Sort([](const FInventorySlot& First, const FInventorySlot& Second)
+	{
+		return First.Slot < Second.Slot;
+	});
+
+	// Stack index: asset -> groups of partial stacks with identical dynamic stats
+	const int StackSize = GetStackSizeConfig();
+	TMap<FPrimaryAssetId, bool> CanStackByAsset;
+	TMap<FPrimaryAssetId, TArray<TArray<int>>> StackIndex;
+	for (int I = 0; I < InventorySlots.Num(); I++)
+	{
+		const FInventorySlot& InventorySlot = InventorySlots[I];
+		if (InventorySlot.Amount >= StackSize)
+		{
+			continue;
+		}
+
+		const bool* CanStack = CanStackByAsset.Find(InventorySlot.Asset);
+		if (!CanStack)
+		{
+			bool TempCanStack = false;
+			FAssetData AssetData;
+			Manager->GetPrimaryAssetData(InventorySlot.Asset, AssetData);
+			if (AssetData.IsValid())
+			{
+				AssetData.GetTagValue(GET_MEMBER_NAME_CHECKED(UItemDataAsset, bCanStack), TempCanStack);
+			}
+
+			CanStack = &CanStackByAsset.Add(InventorySlot.Asset, TempCanStack);
+		}
+
+		if (!*CanStack)
+		{
+			continue;
+		}
+
+		TArray<TArray<int>>& Stacks = StackIndex.FindOrAdd(InventorySlot.Asset);
+		if (TArray<int>* Stack = Stacks.FindByPredicate([&](const TArray<int>& Other) { return InventorySlots[Other[0]].ItemProperties == InventorySlot.ItemProperties; }))
+		{
+			Stack->Add(I);
+			continue;
+		}
+
+		Stacks.Add({I});
+	}
+
+	bool bRemovedSlot = false;
+	for (const TPair<FPrimaryAssetId, TArray<TArray<int>>>& Pair : StackIndex)
+	{
+		for (const TArray<int>& Stack : Pair.Value)
+		{
+			if (Stack.Num() < 2)
+			{
+				continue;
+			}
+
+			int Total = 0;
+			for (const int Index : Stack)
+			{
+				Total += InventorySlots[Index].Amount;
+			}
+
+			for (const int Index : Stack)
+			{
+				InventorySlots[Index].Amount = FMath::Min(Total, StackSize);
+				Total -= InventorySlots[Index].Amount;
+				bRemovedSlot |= InventorySlots[Index].Amount <= 0;
+			}
+		}
+	}
+
+	if (bRemovedSlot)
+	{
+		InventorySlots.RemoveAll([](const FInventorySlot& InventorySlot)
+		{
+			return InventorySlot.Amount <= 0;
+		});
+	}
+
+	return true;
+}
+
+TArray<int> UItemContainerComponent::ApplyInventorySlots(const TArray<FInventorySlot>& NewInventorySlots)
+{
+	TMap<int, int> OldIndicesBySlot;
+	OldIndicesBySlot.Reserve(InventoryIndices.Num());
+	for (int I = 0; I < InventoryIndices.Num(); I++)
+	{
+		OldIndicesBySlot.Add(InventoryIndices[I], I);
+	}
+
+	TMap<int, int> OldDynamicStatsIndicesBySlot;
+	OldDynamicStatsIndicesBySlot.Reserve(InventoryDynamicStatsIndices.Num());
+	for (int I = 0; I < InventoryDynamicStatsIndices.Num(); I++)
+	{
+		OldDynamicStatsIndicesBySlot.Add(InventoryDynamicStatsIndices[I], I);
+	}
+
+	// Only slots with different content count as changed
+	TArray<int> ChangedSlots;
+	TSet<int> NewSlots;
+	NewSlots.Reserve(NewInventorySlots.Num());
+	for (const FInventorySlot& NewInventorySlot : NewInventorySlots)
+	{
+		NewSlots.Add(NewInventorySlot.Slot);
+		const int* OldIndex = OldIndicesBySlot.Find(NewInventorySlot.Slot);
+		if (!OldIndex || !InventoryAssets.IsValidIndex(*OldIndex) || !InventoryAmounts.IsValidIndex(*OldIndex) || InventoryAssets[*OldIndex] != NewInventorySlot.Asset || InventoryAmounts[*OldIndex] != NewInventorySlot.Amount)
+		{
+			ChangedSlots.Add(NewInventorySlot.Slot);
+			continue;
+		}
+
+		const int* OldDynamicStatsIndex = OldDynamicStatsIndicesBySlot.Find(NewInventorySlot.Slot);
+		const bool bHasOldDynamicStats = OldDynamicStatsIndex && InventoryDynamicStats.IsValidIndex(*OldDynamicStatsIndex);
+		if (bHasOldDynamicStats ? !(InventoryDynamicStats[*OldDynamicStatsIndex] == NewInventorySlot.ItemProperties) : !NewInventorySlot.ItemProperties.ItemProperties.IsEmpty())
+		{
+			ChangedSlots.Add(NewInventorySlot.Slot);
+		}
+	}
+
+	for (const int OldSlot : InventoryIndices)
+	{
+		if (!NewSlots.Contains(OldSlot))
+		{
+			ChangedSlots.Add(OldSlot);
+		}
+	}
+
+	if (ChangedSlots.IsEmpty())
+	{
+		return ChangedSlots;
+	}
+
+	ChangedSlots.Sort();
+
+	// Inconsistent arrays can not be patched. Rewrite them in one pass
+	if (InventoryAssets.Num() != InventoryIndices.Num() || InventoryAmounts.Num() != InventoryIndices.Num() || InventoryDynamicStats.Num() != InventoryDynamicStatsIndices.Num())
+	{
+		InventoryIndices.Reset(NewInventorySlots.Num());
+		InventoryAssets.Reset(NewInventorySlots.Num());
+		InventoryAmounts.Reset(NewInventorySlots.Num());
+		InventoryDynamicStatsIndices.Reset();
+		InventoryDynamicStats.Reset();
+		for (const FInventorySlot& NewInventorySlot : NewInventorySlots)
+		{
+			InventoryIndices.Add(NewInventorySlot.Slot);
+			InventoryAssets.Add(NewInventorySlot.Asset);
+			InventoryAmounts.Add(NewInventorySlot.Amount);
+			if (!NewInventorySlot.ItemProperties.ItemProperties.IsEmpty())
+			{
+				InventoryDynamicStatsIndices.Add(NewInventorySlot.Slot);
+				InventoryDynamicStats.Add(NewInventorySlot.ItemProperties);
+			}
+		}
+
+		return ChangedSlots;
+	}
+
+	TMap<int, const FInventorySlot*> NewInventorySlotsBySlot;
+	NewInventorySlotsBySlot.Reserve(NewInventorySlots.Num());
+	for (const FInventorySlot& NewInventorySlot : NewInventorySlots)
+	{
+		NewInventorySlotsBySlot.Add(NewInventorySlot.Slot, &NewInventorySlot);
+	}
+
+	// Move plan: changed slots are written in place, added slots are collected and entries of removed slots are freed
+	TArray<int> FreeIndices;
+	TArray<int> FreeDynamicStatsIndices;
+	TArray<const FInventorySlot*> AddedInventorySlots;
+	TArray<const FInventorySlot*> AddedDynamicStats;
+	for (const int Slot : ChangedSlots)
+	{
+		const int* OldIndex = OldIndicesBySlot.Find(Slot);
+		const int* OldDynamicStatsIndex = OldDynamicStatsIndicesBySlot.Find(Slot);
+		const FInventorySlot* const* FoundInventorySlot = NewInventorySlotsBySlot.Find(Slot);
+		if (FoundInventorySlot == nullptr)
+		{
+			if (OldIndex)
+			{
+				FreeIndices.Add(*OldIndex);
+			}
+			if (OldDynamicStatsIndex)
+			{
+				FreeDynamicStatsIndices.Add(*OldDynamicStatsIndex);
+			}
+			continue;
+		}
+
+		const FInventorySlot& NewInventorySlot = **FoundInventorySlot;
+		if (!OldIndex)
+		{
+			AddedInventorySlots.Add(&NewInventorySlot);
+		}
+		else
+		{
+			if (InventoryAssets[*OldIndex] != NewInventorySlot.Asset)
+			{
+				InventoryAssets[*OldIndex] = NewInventorySlot.Asset;
+			}
+			if (InventoryAmounts[*OldIndex] != NewInventorySlot.Amount)
+			{
+				InventoryAmounts[*OldIndex] = NewInventorySlot.Amount;
+			}
+		}
+
+		const bool bHasNewDynamicStats = !NewInventorySlot.ItemProperties.ItemProperties.IsEmpty();
+		if (!OldDynamicStatsIndex)
+		{
+			if (bHasNewDynamicStats)
+			{
+				AddedDynamicStats.Add(&NewInventorySlot);
+			}
+		}
+		else if (!bHasNewDynamicStats)
+		{
+			FreeDynamicStatsIndices.Add(*OldDynamicStatsIndex);
+		}
+		else if (!(InventoryDynamicStats[*OldDynamicStatsIndex] == NewInventorySlot.ItemProperties))
+		{
+			InventoryDynamicStats[*OldDynamicStatsIndex] = NewInventorySlot.ItemProperties;
+		}
+	}
+
+	// Reuse freed entries for added slots before growing the arrays
+	for (const FInventorySlot* AddedInventorySlot : AddedInventorySlots)
+	{
+		if (FreeIndices.IsEmpty())
+		{
+			InventoryIndices.Add(AddedInventorySlot->Slot);
+			InventoryAssets.Add(AddedInventorySlot->Asset);
+			InventoryAmounts.Add(AddedInventorySlot->Amount);
+			continue;
+		}
+
+		const int Index = FreeIndices.Pop(EAllowShrinking::No);
+		InventoryIndices[Index] = AddedInventorySlot->Slot;
+		InventoryAssets[Index] = AddedInventorySlot->Asset;
+		InventoryAmounts[Index] = AddedInventorySlot->Amount;
+	}
+
+	for (const FInventorySlot* AddedInventorySlot : AddedDynamicStats)
+	{
+		if (FreeDynamicStatsIndices.IsEmpty())
+		{
+			InventoryDynamicStatsIndices.Add(AddedInventorySlot->Slot);
+			InventoryDynamicStats.Add(AddedInventorySlot->ItemProperties);
+			continue;
+		}
+
+		const int Index = FreeDynamicStatsIndices.Pop(EAllowShrinking::No);
+		InventoryDynamicStatsIndices[Index] = AddedInventorySlot->Slot;
+		InventoryDynamicStats[Index] = AddedInventorySlot->ItemProperties;
+	}
+
+	// Remove the remaining entries back to front. The last entry moves into each hole, so nothing else shifts
+	FreeIndices.Sort();
+	for (int I = FreeIndices.Num() - 1; I >= 0; I--)
+	{
+		InventoryIndices.RemoveAtSwap(FreeIndices[I], 1, EAllowShrinking::No);
+		InventoryAssets.RemoveAtSwap(FreeIndices[I], 1, EAllowShrinking::No);
+		InventoryAmounts.RemoveAtSwap(FreeIndices[I], 1, EAllowShrinking::No);
+	}
+
+	FreeDynamicStatsIndices.Sort();
+	for (int I = FreeDynamicStatsIndices.Num() - 1; I >= 0; I--)
+	{
+		InventoryDynamicStatsIndices.RemoveAtSwap(FreeDynamicStatsIndices[I], 1, EAllowShrinking::No);
+		InventoryDynamicStats.RemoveAtSwap(FreeDynamicStatsIndices[I], 1, EAllowShrinking::No);
+	}
+
+	return ChangedSlots;
+}
+
 int UItemContainerComponent::GetStackSizeConfig() const
 {
 	const UInventorySystemSettings* InventorySettings = GetMutableDefault<UInventorySystemSettings>();
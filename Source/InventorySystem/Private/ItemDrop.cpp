@@ -5,6 +5,7 @@
 #include "ImageUtils.h"
 #include "InventorySystem.h"
 #include "InventorySystemComponent.h"
+#include "ItemDropSubsystem.h"
 #include "Components/BillboardComponent.h"
 #include "Engine/AssetManager.h"
 #include "AssetRegistry/AssetData.h"
@@ -19,10 +20,18 @@
 
 #define LOCTEXT_NAMESPACE "InventorySystem"
 
+#if WITH_EDITORONLY_DATA
+TWeakObjectPtr<UTexture2D> AItemDrop::SpriteTexture;
+bool AItemDrop::bIsSpriteTextureImported = false;
+#endif
+
 AItemDrop::AItemDrop()
 {
 	USceneComponent* SceneComponent = CreateDefaultSubobject<USceneComponent>(TEXT("RootComponent0"));
 	SetRootComponent(SceneComponent);
+
+	// Drops rarely change. They only replicate when their item data changes or a pick up is processed
+	NetDormancy = DORM_Initial;
 	
 #if WITH_EDITORONLY_DATA
 	AllowItemAssetEdit = HasActorBegunPlay();
@@ -309,23 +318,32 @@ bool AItemDrop::PickUp_Validate(UInventorySystemComponent* InventorySystemCompon
 
 void AItemDrop::PickUp_Implementation(UInventorySystemComponent* InventorySystemComponent, const bool bCanStack)
 {
-	if (HasAuthority())
+	PickUpDirect(InventorySystemComponent, bCanStack);
+}
+
+bool AItemDrop::PickUpDirect(UInventorySystemComponent* InventorySystemComponent, const bool bCanStack)
+{
+	if (!HasAuthority())
+	{
+		return false;
+	}
+
+	if (bIsProcessing)
+	{
+		UE_LOG(InventorySystem, Error, TEXT("[AItemDrop|%s][PickUp]: AItemDrop is still processing previous request"), *GetFName().ToString());
+		return false;
+	}
+
+	if (!IsValid(InventorySystemComponent) || InventorySystemComponent->bIsProcessing)
 	{
-		if (bIsProcessing)
-		{
-			UE_LOG(InventorySystem, Error, TEXT("[AItemDrop|%s][PickUp]: AItemDrop is still processing previous request"), *GetFName().ToString());
-			return;
-		}
-	
-		bIsProcessing = true;
-		if (IsValid(InventorySystemComponent) && !InventorySystemComponent->bIsProcessing)
-		{
-			InventorySystemComponent->PickUpItemDrop(this, bCanStack);
-			return;
-		}
 		UE_LOG(InventorySystem, Warning, TEXT("[AItemDrop|%s][InternalChecks]: Invalid InventorySystemComponent or still processing"), *GetFName().ToString());
-		bIsProcessing = false;
+		return false;
 	}
+
+	// Reset by AfterPickUpEvent
+	SetNetDormancy(DORM_Awake);
+	bIsProcessing = true;
+	return InventorySystemComponent->PickUpItemDropDirect(this, bCanStack);
 }
 
 void AItemDrop::AfterPickUpEvent_Implementation(const bool bSuccess)
@@ -334,11 +352,26 @@ void AItemDrop::AfterPickUpEvent_Implementation(const bool bSuccess)
 	{
 		if (bDestroyAfterPickUp && Amount <= 0)
 		{
-			Destroy();	
+			// The subsystem destroys the drop if the pool is full
+			if (UItemDropSubsystem* ItemDropSubsystem = GetWorld()->GetSubsystem<UItemDropSubsystem>(); IsValid(ItemDropSubsystem))
+			{
+				ItemDropSubsystem->ReleaseItemDrop(this);
+			}
+			else
+			{
+				Destroy();
+			}
 		}
 	}
 
 	bIsProcessing = false;
+
+	// Send the changed amount once and go back to sleep
+	if (HasAuthority() && !IsActorBeingDestroyed() && !bIsPooled)
+	{
+		SetNetDormancy(DORM_DormantAll);
+		FlushNetDormancy();
+	}
 }
 
 void AItemDrop::OnConstruction(const FTransform& Transform)
@@ -351,26 +384,49 @@ void AItemDrop::OnConstruction(const FTransform& Transform)
 	
 	if (IsValid(SpriteComponent))
 	{
-		const FString BaseDir = IPluginManager::Get().FindPlugin("InventorySystem")->GetBaseDir();
-		const FString TexturePath = FPaths::Combine(*BaseDir, TEXT("Resources/ItemDrop128.png"));
-
-		UTexture2D* NewTexture = FImageUtils::ImportFileAsTexture2D(TexturePath);
-		
-		SpriteComponent->SetSprite(NewTexture);
+		SpriteComponent->SetSprite(GetSpriteTexture());
 	}
 #endif
 	
 	Super::OnConstruction(Transform);
 }
 
+#if WITH_EDITORONLY_DATA
+UTexture2D* AItemDrop::GetSpriteTexture()
+{
+	// Import only once instead of creating a new texture on every construction script run
+	if (!SpriteTexture.IsValid() && !bIsSpriteTextureImported)
+	{
+		bIsSpriteTextureImported = true;
+
+		const FString BaseDir = IPluginManager::Get().FindPlugin("InventorySystem")->GetBaseDir();
+		const FString TexturePath = FPaths::Combine(*BaseDir, TEXT("Resources/ItemDrop128.png"));
+
+		if (UTexture2D* NewTexture = FImageUtils::ImportFileAsTexture2D(TexturePath); IsValid(NewTexture))
+		{
+			NewTexture->AddToRoot();
+			SpriteTexture = NewTexture;
+		}
+		else
+		{
+			UE_LOG(InventorySystem, Warning, TEXT("[AItemDrop][GetSpriteTexture]: Unable to import %s"), *TexturePath);
+		}
+	}
+
+	return SpriteTexture.Get();
+}
+#endif
+
 void AItemDrop::BeginPlay()
 {
 	Super::BeginPlay();
-	
-	InternalChecks(true);
-	
-	if (MaxRandomAmount > 1 && MinRandomAmount > 0 && MaxRandomAmount > MinRandomAmount) {
-		Amount = FMath::RandRange(MinRandomAmount, MaxRandomAmount);
+
+	InitializeItemDrop();
+
+	if (!IsActorBeingDestroyed())
+	{
+		GetRootComponent()->TransformUpdated.AddUObject(this, &AItemDrop::HandleRootTransformUpdated);
+		ItemChangedEvent();
 	}
 
 #if WITH_EDITORONLY_DATA
@@ -379,16 +435,148 @@ void AItemDrop::BeginPlay()
 #endif
 }
 
-#if WITH_EDITORONLY_DATA
+void AItemDrop::InitializeItemDrop()
+{
+	const int PreviousAmount = Amount;
+
+	// Batched spawns validate all entries at once and define the amount themselves
+	if (bIsItemDataValidated)
+	{
+		bIsItemDataValidated = false;
+	}
+	else
+	{
+		InternalChecks(true);
+
+		if (MaxRandomAmount > 1 && MinRandomAmount > 0 && MaxRandomAmount > MinRandomAmount) {
+			Amount = FMath::RandRange(MinRandomAmount, MaxRandomAmount);
+		}
+	}
+
+	if (!IsActorBeingDestroyed())
+	{
+		if (UItemDropSubsystem* ItemDropSubsystem = GetWorld()->GetSubsystem<UItemDropSubsystem>(); IsValid(ItemDropSubsystem))
+		{
+			ItemDropSubsystem->RegisterItemDrop(this);
+		}
+
+		// Spawned drops replicate once and go dormant. Placed drops stay dormant unless their amount differs from the level
+		if (HasAuthority())
+		{
+			if (!IsNetStartupActor())
+			{
+				SetNetDormancy(DORM_DormantAll);
+			}
+			else if (Amount != PreviousAmount)
+			{
+				FlushNetDormancy();
+			}
+		}
+	}
+}
+
+void AItemDrop::ActivatePooled(const FPrimaryAssetId& NewInventoryAsset, const int NewAmount, const FItemProperties& NewDynamicStats, const FTransform& Transform)
+{
+	bIsPooled = false;
+	bIsProcessing = false;
+	InventoryAsset = NewInventoryAsset;
+	Amount = NewAmount;
+	DynamicStats = NewDynamicStats;
+
+	// Clients only know the location the drop was spawned at. Replicate the move to the new location
+	SetReplicatingMovement(true);
+	SetActorTransform(Transform, false, nullptr, ETeleportType::ResetPhysics);
+	SetActorEnableCollision(true);
+	SetActorHiddenInGame(false);
+
+	InitializeItemDrop();
+
+	// Replicate the new item data of the dormant drop
+	if (!IsActorBeingDestroyed())
+	{
+		FlushNetDormancy();
+		ItemChangedEvent();
+	}
+}
+
+void AItemDrop::OnRep_InventoryAsset()
+{
+	// Drops received with their first replication are set up by BeginPlay
+	if (!HasActorBegunPlay() || IsActorBeingDestroyed())
+	{
+		return;
+	}
+
+	UItemDropSubsystem* ItemDropSubsystem = GetWorld()->GetSubsystem<UItemDropSubsystem>();
+	if (!InventoryAsset.IsValid() || InventoryAsset == FPrimaryAssetId())
+	{
+		// Released into the pool on the server
+		if (IsValid(ItemDropSubsystem))
+		{
+			ItemDropSubsystem->UnregisterItemDrop(this);
+		}
+		return;
+	}
+
+	// Reused for another item. Update InternalCanStack and the grid cell for local queries
+	InternalChecks(false);
+	if (IsValid(ItemDropSubsystem))
+	{
+		ItemDropSubsystem->RegisterItemDrop(this);
+	}
+
+	ItemChangedEvent();
+}
+
+void AItemDrop::DeactivatePooled()
+{
+	if (UItemDropSubsystem* ItemDropSubsystem = GetWorld()->GetSubsystem<UItemDropSubsystem>(); IsValid(ItemDropSubsystem))
+	{
+		ItemDropSubsystem->UnregisterItemDrop(this);
+	}
+
+	bIsPooled = true;
+	bIsProcessing = false;
+	InventoryAsset = FPrimaryAssetId();
+	Amount = 0;
+	DynamicStats = FItemProperties();
+
+	SetActorHiddenInGame(true);
+	SetActorEnableCollision(false);
+
+	// The hidden state is sent with the last update before the actor channel goes dormant
+	FlushNetDormancy();
+	SetNetDormancy(DORM_DormantAll);
+}
+
+void AItemDrop::HandleRootTransformUpdated(USceneComponent* UpdatedComponent, EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport)
+{
+	if (UItemDropSubsystem* ItemDropSubsystem = GetWorld()->GetSubsystem<UItemDropSubsystem>(); IsValid(ItemDropSubsystem))
+	{
+		ItemDropSubsystem->UpdateItemDrop(this);
+	}
+}
+
 void AItemDrop::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
+	if (UItemDropSubsystem* ItemDropSubsystem = GetWorld()->GetSubsystem<UItemDropSubsystem>(); IsValid(ItemDropSubsystem))
+	{
+		ItemDropSubsystem->UnregisterItemDrop(this);
+	}
+
+	if (USceneComponent* SceneComponent = GetRootComponent(); IsValid(SceneComponent))
+	{
+		SceneComponent->TransformUpdated.RemoveAll(this);
+	}
+
 	Super::EndPlay(EndPlayReason);
 
+#if WITH_EDITORONLY_DATA
 	bHasBegunPlayEditor = false;
 
 	InternalChecks();
-}
 #endif
+}
 
 int AItemDrop::GetStackSizeConfig() const
 {
@@ -396,4 +584,33 @@ int AItemDrop::GetStackSizeConfig() const
 	return MaxStackSize > 1 ? MaxStackSize : InventorySettings->MaxItemDropStackSize;
 }
 
+bool AItemDrop::CanStack() const
+{
+	return InternalCanStack;
+}
+
+bool AItemDrop::IsProcessing() const
+{
+	return bIsProcessing;
+}
+
+bool AItemDrop::IsPooled() const
+{
+	return bIsPooled;
+}
+
+void AItemDrop::MarkItemDataValidated(const bool bCanStack)
+{
+	InternalCanStack = bCanStack;
+	bIsItemDataValidated = true;
+}
+
+void AItemDrop::FlushItemData()
+{
+	if (HasAuthority())
+	{
+		FlushNetDormancy();
+	}
+}
+
 #undef LOCTEXT_NAMESPACE
\ No newline at end of file
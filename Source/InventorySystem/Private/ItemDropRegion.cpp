@@ -0,0 +1,258 @@
+﻿// © 2024 Daniel Münch. All Rights Reserved
+
+#include "ItemDropRegion.h"
+
+#include "InventorySystem.h"
+#include "ItemDataAsset.h"
+#include "ItemDropSubsystem.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "Engine/AssetManager.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/World.h"
+#include "Net/UnrealNetwork.h"
+#include "Settings/InventorySystemSettings.h"
+#include "UI/ItemVisualsPreloadSubsystem.h"
+
+#define LOCTEXT_NAMESPACE "InventorySystem"
+
+void FItemDropInstanceArray::PostReplicatedAdd(const TArrayView<int32>& AddedIndices, int32 FinalSize)
+{
+	for (const int Index : AddedIndices)
+	{
+		if (IsValid(Owner))
+		{
+			Owner->MarkAssetDirty(Items[Index].InventoryAsset);
+		}
+	}
+}
+
+void FItemDropInstanceArray::PostReplicatedChange(const TArrayView<int32>& ChangedIndices, int32 FinalSize)
+{
+	for (const int Index : ChangedIndices)
+	{
+		if (IsValid(Owner))
+		{
+			Owner->MarkAssetDirty(Items[Index].InventoryAsset);
+		}
+	}
+}
+
+void FItemDropInstanceArray::PreReplicatedRemove(const TArrayView<int32>& RemovedIndices, int32 FinalSize)
+{
+	for (const int Index : RemovedIndices)
+	{
+		if (IsValid(Owner))
+		{
+			Owner->MarkAssetDirty(Items[Index].InventoryAsset);
+		}
+	}
+}
+
+AItemDropRegion::AItemDropRegion()
+{
+	PrimaryActorTick.bCanEverTick = false;
+	bReplicates = true;
+
+	USceneComponent* SceneComponent = CreateDefaultSubobject<USceneComponent>(TEXT("RootComponent0"));
+	SetRootComponent(SceneComponent);
+
+	const UInventorySystemSettings* InventorySettings = GetMutableDefault<UInventorySystemSettings>();
+	SetNetCullDistanceSquared(FMath::Square(InventorySettings->LightweightItemDropNetCullDistance));
+
+	ItemDropInstances.Owner = this;
+}
+
+void AItemDropRegion::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+	DOREPLIFETIME(AItemDropRegion, ItemDropInstances);
+}
+
+void AItemDropRegion::BeginPlay()
+{
+	Super::BeginPlay();
+
+	if (UItemDropSubsystem* ItemDropSubsystem = GetWorld()->GetSubsystem<UItemDropSubsystem>(); IsValid(ItemDropSubsystem))
+	{
+		ItemDropSubsystem->RegisterItemDropRegion(this);
+	}
+}
+
+void AItemDropRegion::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UItemDropSubsystem* ItemDropSubsystem = GetWorld()->GetSubsystem<UItemDropSubsystem>(); IsValid(ItemDropSubsystem))
+	{
+		ItemDropSubsystem->UnregisterItemDropRegion(this);
+	}
+
+	if (UItemVisualsPreloadSubsystem* ItemVisualsPreloadSubsystem = UItemVisualsPreloadSubsystem::Get(this); IsValid(ItemVisualsPreloadSubsystem))
+	{
+		ItemVisualsPreloadSubsystem->ItemVisualsLoadedDelegate.RemoveDynamic(this, &AItemDropRegion::HandleItemVisualsLoaded);
+		ItemVisualsPreloadSubsystem->ReleaseItemVisuals(this);
+	}
+
+	GetWorldTimerManager().ClearAllTimersForObject(this);
+
+	Super::EndPlay(EndPlayReason);
+}
+
+bool AItemDropRegion::ShouldRender() const
+{
+	return GetNetMode() != NM_DedicatedServer;
+}
+
+void AItemDropRegion::AddItemDropInstance(const FItemDropInstance& ItemDropInstance)
+{
+	const int Index = ItemDropInstances.Items.Add(ItemDropInstance);
+	ItemDropInstanceIndexById.Add(ItemDropInstance.Id, Index);
+	ItemDropInstances.MarkItemDirty(ItemDropInstances.Items[Index]);
+	MarkAssetDirty(ItemDropInstance.InventoryAsset);
+}
+
+bool AItemDropRegion::RemoveItemDropInstance(const int Id, FItemDropInstance& OutItemDropInstance)
+{
+	int Index;
+	if (!ItemDropInstanceIndexById.RemoveAndCopyValue(Id, Index))
+	{
+		return false;
+	}
+
+	OutItemDropInstance = ItemDropInstances.Items[Index];
+	ItemDropInstances.Items.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+
+	// The last drop moved into the removed index
+	if (ItemDropInstances.Items.IsValidIndex(Index))
+	{
+		ItemDropInstanceIndexById.Add(ItemDropInstances.Items[Index].Id, Index);
+	}
+
+	ItemDropInstances.MarkArrayDirty();
+	MarkAssetDirty(OutItemDropInstance.InventoryAsset);
+	return true;
+}
+
+const FItemDropInstance* AItemDropRegion::FindItemDropInstance(const int Id) const
+{
+	const int* Index = ItemDropInstanceIndexById.Find(Id);
+	return Index != nullptr && ItemDropInstances.Items.IsValidIndex(*Index) ? &ItemDropInstances.Items[*Index] : nullptr;
+}
+
+const TArray<FItemDropInstance>& AItemDropRegion::GetItemDropInstances() const
+{
+	return ItemDropInstances.Items;
+}
+
+void AItemDropRegion::MarkAssetDirty(const FPrimaryAssetId& Asset)
+{
+	if (!ShouldRender())
+	{
+		return;
+	}
+
+	DirtyAssets.Add(Asset);
+
+	// Many drops change at once while spawning loot or replicating a region. Rebuild once per frame
+	if (!bIsRebuildScheduled && IsValid(GetWorld()))
+	{
+		bIsRebuildScheduled = true;
+		GetWorldTimerManager().SetTimerForNextTick(this, &AItemDropRegion::RebuildInstancedMeshes);
+	}
+}
+
+void AItemDropRegion::RebuildInstancedMeshes()
+{
+	bIsRebuildScheduled = false;
+	if (DirtyAssets.IsEmpty())
+	{
+		return;
+	}
+
+	TMap<FPrimaryAssetId, TArray<FTransform>> TransformsByAsset;
+	for (const FItemDropInstance& ItemDropInstance : ItemDropInstances.Items)
+	{
+		if (DirtyAssets.Contains(ItemDropInstance.InventoryAsset))
+		{
+			TransformsByAsset.FindOrAdd(ItemDropInstance.InventoryAsset).Add(ItemDropInstance.Transform);
+		}
+	}
+
+	RequestItemVisuals();
+
+	const UAssetManager* AssetManager = UAssetManager::GetIfInitialized();
+	for (const FPrimaryAssetId& Asset : DirtyAssets)
+	{
+		const TArray<FTransform>* Transforms = TransformsByAsset.Find(Asset);
+		TObjectPtr<UInstancedStaticMeshComponent>* InstancedMesh = InstancedMeshes.Find(Asset);
+		if (Transforms == nullptr)
+		{
+			// No drop of this item left
+			if (InstancedMesh != nullptr && IsValid(*InstancedMesh))
+			{
+				(*InstancedMesh)->DestroyComponent();
+			}
+			InstancedMeshes.Remove(Asset);
+			continue;
+		}
+
+		// Mesh is not loaded yet. Rebuilt by HandleItemVisualsLoaded
+		const UItemDataAsset* ItemDataAsset = IsValid(AssetManager) ? AssetManager->GetPrimaryAssetObject<UItemDataAsset>(Asset) : nullptr;
+		UStaticMesh* DropMesh = IsValid(ItemDataAsset) ? ItemDataAsset->DropMesh.Get() : nullptr;
+		if (!IsValid(DropMesh))
+		{
+			continue;
+		}
+
+		if (InstancedMesh == nullptr || !IsValid(*InstancedMesh))
+		{
+			UInstancedStaticMeshComponent* NewInstancedMesh = NewObject<UInstancedStaticMeshComponent>(this);
+			NewInstancedMesh->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+			NewInstancedMesh->SetupAttachment(GetRootComponent());
+			NewInstancedMesh->RegisterComponent();
+			InstancedMesh = &InstancedMeshes.Add(Asset, NewInstancedMesh);
+		}
+
+		(*InstancedMesh)->SetStaticMesh(DropMesh);
+		(*InstancedMesh)->ClearInstances();
+		(*InstancedMesh)->AddInstances(*Transforms, false, true);
+	}
+
+	DirtyAssets.Empty();
+}
+
+void AItemDropRegion::RequestItemVisuals()
+{
+	UItemVisualsPreloadSubsystem* ItemVisualsPreloadSubsystem = UItemVisualsPreloadSubsystem::Get(this);
+	if (!IsValid(ItemVisualsPreloadSubsystem))
+	{
+		return;
+	}
+
+	TSet<FPrimaryAssetId> Assets;
+	for (const FItemDropInstance& ItemDropInstance : ItemDropInstances.Items)
+	{
+		Assets.Add(ItemDropInstance.InventoryAsset);
+	}
+
+	ItemVisualsPreloadSubsystem->ItemVisualsLoadedDelegate.AddUniqueDynamic(this, &AItemDropRegion::HandleItemVisualsLoaded);
+	ItemVisualsPreloadSubsystem->RequestItemVisuals(this, Assets.Array(), TArray<FPrimaryAssetId>());
+}
+
+void AItemDropRegion::HandleItemVisualsLoaded(const FPrimaryAssetId& Asset)
+{
+	if (InstancedMeshes.Contains(Asset))
+	{
+		return;
+	}
+
+	for (const FItemDropInstance& ItemDropInstance : ItemDropInstances.Items)
+	{
+		if (ItemDropInstance.InventoryAsset == Asset)
+		{
+			MarkAssetDirty(Asset);
+			return;
+		}
+	}
+}
+
+#undef LOCTEXT_NAMESPACE
@@ -0,0 +1,998 @@
+﻿// © 2024 Daniel Münch. All Rights Reserved
+
+#include "ItemDropSubsystem.h"
+
+#include "InventorySystem.h"
+#include "ItemDrop.h"
+#include "ItemDropRegion.h"
+#include "AssetRegistry/AssetData.h"
+#include "Engine/AssetManager.h"
+#include "Engine/World.h"
+#include "TimerManager.h"
+#include "Settings/InventorySystemSettings.h"
+
+#define LOCTEXT_NAMESPACE "InventorySystem"
+
+bool UItemDropSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UItemDropSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	const UInventorySystemSettings* InventorySettings = GetMutableDefault<UInventorySystemSettings>();
+	CellSize = FMath::Max(InventorySettings->ItemDropGridCellSize, 1.f);
+	PoolSize = FMath::Max(InventorySettings->ItemDropPoolSize, 0);
+	bMergeItemDrops = InventorySettings->bMergeItemDrops;
+	MergeRadius = FMath::Max(InventorySettings->ItemDropMergeRadius, 0.f);
+	RegionSize = FMath::Max(InventorySettings->LightweightItemDropRegionSize, 1.f);
+
+	DespawnWheel.SetNum(DespawnWheelLevels * DespawnWheelSlots);
+	SpawnBudget = FMath::Max(InventorySettings->ItemDropSpawnBudget, 0.1f) / 1000.0;
+}
+
+void UItemDropSubsystem::Deinitialize()
+{
+	ItemDropCells.Empty();
+	ItemDropCellByDrop.Empty();
+	PooledItemDrops.Empty();
+	PendingMergeItemDrops.Empty();
+	ItemDropRegions.Empty();
+	ItemDropRegionById.Empty();
+	DespawnWheel.Empty();
+	DespawnTickByDrop.Empty();
+	DespawnTickByLightweightId.Empty();
+	SpawnBatches.Empty();
+	ItemDropAssetInfos.Empty();
+
+	Super::Deinitialize();
+}
+
+FIntVector UItemDropSubsystem::GetCell(const FVector& Location) const
+{
+	return FIntVector(FMath::FloorToInt(Location.X / CellSize), FMath::FloorToInt(Location.Y / CellSize), FMath::FloorToInt(Location.Z / CellSize));
+}
+
+void UItemDropSubsystem::RemoveFromCell(const AItemDrop* ItemDrop, const FIntVector& Cell)
+{
+	TArray<TWeakObjectPtr<AItemDrop>>* ItemDrops = ItemDropCells.Find(Cell);
+	if (ItemDrops == nullptr)
+	{
+		return;
+	}
+
+	// Drop stale entries of destroyed actors while searching
+	for (int Index = ItemDrops->Num() - 1; Index >= 0; Index--)
+	{
+		if (const AItemDrop* CellItemDrop = (*ItemDrops)[Index].Get(); CellItemDrop == nullptr || CellItemDrop == ItemDrop)
+		{
+			ItemDrops->RemoveAtSwap(Index, 1, EAllowShrinking::No);
+		}
+	}
+
+	if (ItemDrops->IsEmpty())
+	{
+		ItemDropCells.Remove(Cell);
+	}
+}
+
+bool UItemDropSubsystem::MatchesQuery(const AItemDrop* ItemDrop, const FItemDropQuery& Query)
+{
+	if (!IsValid(ItemDrop) || ItemDrop->IsActorBeingDestroyed() || ItemDrop->Amount <= 0)
+	{
+		return false;
+	}
+
+	if (Query.Asset.IsValid() && ItemDrop->InventoryAsset != Query.Asset)
+	{
+		return false;
+	}
+
+	switch (Query.StackFilter)
+	{
+	case EItemDropStackFilter::Stackable:
+		return ItemDrop->CanStack();
+	case EItemDropStackFilter::NotStackable:
+		return !ItemDrop->CanStack();
+	default:
+		return true;
+	}
+}
+
+void UItemDropSubsystem::RegisterItemDrop(AItemDrop* ItemDrop)
+{
+	if (!IsValid(ItemDrop) || ItemDropCellByDrop.Contains(ItemDrop))
+	{
+		return;
+	}
+
+	const FIntVector Cell = GetCell(ItemDrop->GetActorLocation());
+	ItemDropCells.FindOrAdd(Cell).Add(ItemDrop);
+	ItemDropCellByDrop.Add(ItemDrop, Cell);
+
+	// Drops spawned in the same frame, for example by a killed group, are merged together on the next tick
+	if (bMergeItemDrops && ItemDrop->GetNetMode() != NM_Client && ItemDrop->CanStack())
+	{
+		if (PendingMergeItemDrops.IsEmpty())
+		{
+			GetWorld()->GetTimerManager().SetTimerForNextTick(FTimerDelegate::CreateUObject(this, &UItemDropSubsystem::MergePendingItemDrops));
+		}
+		PendingMergeItemDrops.Add(ItemDrop);
+	}
+
+	// Placed drops are part of the level and never despawn
+	if (ItemDrop->GetNetMode() != NM_Client && !ItemDrop->IsNetStartupActor())
+	{
+		ScheduleItemDropDespawn(ItemDrop, GetItemDropLifetime(ItemDrop->InventoryAsset));
+	}
+}
+
+void UItemDropSubsystem::UnregisterItemDrop(const AItemDrop* ItemDrop)
+{
+	DespawnTickByDrop.Remove(ItemDrop);
+
+	FIntVector Cell;
+	if (!ItemDropCellByDrop.RemoveAndCopyValue(ItemDrop, Cell))
+	{
+		return;
+	}
+
+	RemoveFromCell(ItemDrop, Cell);
+}
+
+void UItemDropSubsystem::UpdateItemDrop(AItemDrop* ItemDrop)
+{
+	FIntVector* Cell = ItemDropCellByDrop.Find(ItemDrop);
+	if (Cell == nullptr || !IsValid(ItemDrop))
+	{
+		return;
+	}
+
+	// Most moves stay inside the same cell
+	const FIntVector NewCell = GetCell(ItemDrop->GetActorLocation());
+	if (NewCell == *Cell)
+	{
+		return;
+	}
+
+	RemoveFromCell(ItemDrop, *Cell);
+	ItemDropCells.FindOrAdd(NewCell).Add(ItemDrop);
+	*Cell = NewCell;
+}
+
+TArray<AItemDrop*> UItemDropSubsystem::GetItemDropsInRadius(const FVector& Location, const float Radius, const FItemDropQuery& Query) const
+{
+	TArray<AItemDrop*> Result;
+	if (Radius < 0.f)
+	{
+		return Result;
+	}
+
+	const double RadiusSquared = FMath::Square(static_cast<double>(Radius));
+	const FIntVector MinCell = GetCell(Location - FVector(Radius));
+	const FIntVector MaxCell = GetCell(Location + FVector(Radius));
+
+	const auto CollectCell = [&](const TArray<TWeakObjectPtr<AItemDrop>>& ItemDrops)
+	{
+		for (const TWeakObjectPtr<AItemDrop>& WeakItemDrop : ItemDrops)
+		{
+			if (AItemDrop* ItemDrop = WeakItemDrop.Get(); MatchesQuery(ItemDrop, Query) && FVector::DistSquared(ItemDrop->GetActorLocation(), Location) <= RadiusSquared)
+			{
+				Result.Add(ItemDrop);
+			}
+		}
+	};
+
+	// Visit the occupied cells directly if the searched box covers more cells than exist
+	const int64 BoxCellCount = static_cast<int64>(MaxCell.X - MinCell.X + 1) * (MaxCell.Y - MinCell.Y + 1) * (MaxCell.Z - MinCell.Z + 1);
+	if (BoxCellCount > ItemDropCells.Num())
+	{
+		for (const TPair<FIntVector, TArray<TWeakObjectPtr<AItemDrop>>>& ItemDropCell : ItemDropCells)
+		{
+			const FIntVector& Cell = ItemDropCell.Key;
+			if (Cell.X >= MinCell.X && Cell.X <= MaxCell.X && Cell.Y >= MinCell.Y && Cell.Y <= MaxCell.Y && Cell.Z >= MinCell.Z && Cell.Z <= MaxCell.Z)
+			{
+				CollectCell(ItemDropCell.Value);
+			}
+		}
+		return Result;
+	}
+
+	for (int X = MinCell.X; X <= MaxCell.X; X++)
+	{
+		for (int Y = MinCell.Y; Y <= MaxCell.Y; Y++)
+		{
+			for (int Z = MinCell.Z; Z <= MaxCell.Z; Z++)
+			{
+				if (const TArray<TWeakObjectPtr<AItemDrop>>* ItemDrops = ItemDropCells.Find(FIntVector(X, Y, Z)))
+				{
+					CollectCell(*ItemDrops);
+				}
+			}
+		}
+	}
+
+	return Result;
+}
+
+TArray<AItemDrop*> UItemDropSubsystem::GetNearestItemDrops(const FVector& Location, const int Count, const float MaxRadius, const FItemDropQuery& Query) const
+{
+	TArray<AItemDrop*> Result;
+	if (Count <= 0 || MaxRadius < 0.f || ItemDropCells.IsEmpty())
+	{
+		return Result;
+	}
+
+	const double MaxRadiusSquared = FMath::Square(static_cast<double>(MaxRadius));
+	const FIntVector CenterCell = GetCell(Location);
+	const int MaxRing = FMath::CeilToInt(MaxRadius / CellSize);
+
+	TArray<TPair<double, AItemDrop*>> Candidates;
+	const auto CollectCell = [&](const TArray<TWeakObjectPtr<AItemDrop>>& ItemDrops)
+	{
+		for (const TWeakObjectPtr<AItemDrop>& WeakItemDrop : ItemDrops)
+		{
+			if (AItemDrop* ItemDrop = WeakItemDrop.Get(); MatchesQuery(ItemDrop, Query))
+			{
+				if (const double DistanceSquared = FVector::DistSquared(ItemDrop->GetActorLocation(), Location); DistanceSquared <= MaxRadiusSquared)
+				{
+					Candidates.Emplace(DistanceSquared, ItemDrop);
+				}
+			}
+		}
+	};
+
+	const auto SortCandidates = [&Candidates]()
+	{
+		Candidates.Sort([](const TPair<double, AItemDrop*>& First, const TPair<double, AItemDrop*>& Second)
+		{
+			return First.Key < Second.Key;
+		});
+	};
+
+	// Visit the cells ring by ring around the center cell
+	for (int Ring = 0; Ring <= MaxRing; Ring++)
+	{
+		// Sparse grids: visit all remaining occupied cells at once instead of many empty cells
+		if (const int64 RingCellCount = Ring == 0 ? 1 : FMath::Cube(2ll * Ring + 1) - FMath::Cube(2ll * Ring - 1); RingCellCount > ItemDropCells.Num())
+		{
+			for (const TPair<FIntVector, TArray<TWeakObjectPtr<AItemDrop>>>& ItemDropCell : ItemDropCells)
+			{
+				const FIntVector Offset = ItemDropCell.Key - CenterCell;
+				if (const int CellRing = FMath::Max3(FMath::Abs(Offset.X), FMath::Abs(Offset.Y), FMath::Abs(Offset.Z)); CellRing >= Ring && CellRing <= MaxRing)
+				{
+					CollectCell(ItemDropCell.Value);
+				}
+			}
+			break;
+		}
+
+		for (int X = -Ring; X <= Ring; X++)
+		{
+			for (int Y = -Ring; Y <= Ring; Y++)
+			{
+				// Inside the ring only the top and bottom layer belong to it
+				const bool bIsRingSide = FMath::Abs(X) == Ring || FMath::Abs(Y) == Ring;
+				for (int Z = -Ring; Z <= Ring; Z += bIsRingSide || Ring == 0 ? 1 : 2 * Ring)
+				{
+					if (const TArray<TWeakObjectPtr<AItemDrop>>* ItemDrops = ItemDropCells.Find(CenterCell + FIntVector(X, Y, Z)))
+					{
+						CollectCell(*ItemDrops);
+					}
+				}
+			}
+		}
+
+		// Cells of the next ring are at least Ring * CellSize away from the location
+		if (Candidates.Num() >= Count)
+		{
+			SortCandidates();
+			if (Candidates[Count - 1].Key <= FMath::Square(static_cast<double>(Ring) * CellSize))
+			{
+				break;
+			}
+		}
+	}
+
+	SortCandidates();
+	Result.Reserve(FMath::Min(Count, Candidates.Num()));
+	for (int Index = 0; Index < Candidates.Num() && Index < Count; Index++)
+	{
+		Result.Add(Candidates[Index].Value);
+	}
+
+	return Result;
+}
+
+int UItemDropSubsystem::GetRegisteredItemDropCount() const
+{
+	return ItemDropCellByDrop.Num();
+}
+
+AItemDrop* UItemDropSubsystem::TakePooledItemDrop(const UClass* ItemDropClass)
+{
+	TArray<TWeakObjectPtr<AItemDrop>>* ItemDrops = PooledItemDrops.Find(ItemDropClass);
+	if (ItemDrops == nullptr)
+	{
+		return nullptr;
+	}
+
+	// Skip drops destroyed while pooled, for example by a level unload
+	while (!ItemDrops->IsEmpty())
+	{
+		AItemDrop* ItemDrop = ItemDrops->Pop(EAllowShrinking::No).Get();
+		PoolStatistics.PooledCount--;
+		if (IsValid(ItemDrop) && !ItemDrop->IsActorBeingDestroyed())
+		{
+			return ItemDrop;
+		}
+	}
+
+	return nullptr;
+}
+
+AItemDrop* UItemDropSubsystem::SpawnItemDrop(const TSubclassOf<AItemDrop> ItemDropClass, const FPrimaryAssetId& InventoryAsset, const int Amount, const FItemProperties& DynamicStats, const FTransform& Transform)
+{
+	return SpawnItemDropInternal(ItemDropClass, InventoryAsset, Amount, DynamicStats, Transform, false, false);
+}
+
+AItemDrop* UItemDropSubsystem::SpawnItemDropInternal(const TSubclassOf<AItemDrop>& ItemDropClass, const FPrimaryAssetId& InventoryAsset, const int Amount, const FItemProperties& DynamicStats, const FTransform& Transform, const bool bIsValidated, const bool bCanStack)
+{
+	UWorld* World = GetWorld();
+	if (!IsValid(ItemDropClass) || ItemDropClass->HasAnyClassFlags(CLASS_Abstract) || !IsValid(World) || World->GetNetMode() == NM_Client)
+	{
+		UE_LOG(InventorySystem, Error, TEXT("[UItemDropSubsystem|%s][SpawnItemDrop]: ItemDropClass is invalid or world has no authority"), *GetFName().ToString());
+		return nullptr;
+	}
+
+	if (AItemDrop* ItemDrop = TakePooledItemDrop(ItemDropClass))
+	{
+		PoolStatistics.ReusedCount++;
+		if (bIsValidated)
+		{
+			ItemDrop->MarkItemDataValidated(bCanStack);
+		}
+		ItemDrop->ActivatePooled(InventoryAsset, Amount, DynamicStats, Transform);
+		return ItemDrop->IsActorBeingDestroyed() ? nullptr : ItemDrop;
+	}
+
+	AItemDrop* ItemDrop = World->SpawnActorDeferred<AItemDrop>(ItemDropClass, Transform, nullptr, nullptr, ESpawnActorCollisionHandlingMethod::AlwaysSpawn);
+	if (!IsValid(ItemDrop))
+	{
+		UE_LOG(InventorySystem, Error, TEXT("[UItemDropSubsystem|%s][SpawnItemDrop]: Unable to spawn ItemDrop"), *GetFName().ToString());
+		return nullptr;
+	}
+
+	PoolStatistics.SpawnedCount++;
+	ItemDrop->InventoryAsset = InventoryAsset;
+	ItemDrop->Amount = Amount;
+	ItemDrop->DynamicStats = DynamicStats;
+	if (bIsValidated)
+	{
+		ItemDrop->MarkItemDataValidated(bCanStack);
+	}
+	ItemDrop->FinishSpawning(Transform);
+
+	// BeginPlay destroys drops that are not set up properly
+	return ItemDrop->IsActorBeingDestroyed() ? nullptr : ItemDrop;
+}
+
+bool UItemDropSubsystem::ReleaseItemDrop(AItemDrop* ItemDrop)
+{
+	if (!IsValid(ItemDrop) || ItemDrop->IsActorBeingDestroyed() || ItemDrop->IsPooled())
+	{
+		return false;
+	}
+
+	// Startup actors are loaded with the level on clients and can not be reused as a different drop
+	TArray<TWeakObjectPtr<AItemDrop>>& ItemDrops = PooledItemDrops.FindOrAdd(ItemDrop->GetClass());
+	if (ItemDrops.Num() >= PoolSize || ItemDrop->IsNetStartupActor() || ItemDrop->GetNetMode() == NM_Client)
+	{
+		PoolStatistics.DestroyedCount++;
+		ItemDrop->Destroy();
+		return false;
+	}
+
+	ItemDrop->DeactivatePooled();
+	ItemDrops.Add(ItemDrop);
+	PoolStatistics.ReleasedCount++;
+	PoolStatistics.PooledCount++;
+	PoolStatistics.PeakPooledCount = FMath::Max(PoolStatistics.PeakPooledCount, PoolStatistics.PooledCount);
+	return true;
+}
+
+FItemDropPoolStatistics UItemDropSubsystem::GetPoolStatistics() const
+{
+	return PoolStatistics;
+}
+
+UItemDropSubsystem::FItemDropAssetInfo UItemDropSubsystem::GetItemDropAssetInfo(const FPrimaryAssetId& InventoryAsset) const
+{
+	if (const FItemDropAssetInfo* ItemDropAssetInfo = ItemDropAssetInfos.Find(InventoryAsset))
+	{
+		return *ItemDropAssetInfo;
+	}
+
+	FItemDropAssetInfo ItemDropAssetInfo;
+	if (const UAssetManager* AssetManager = UAssetManager::GetIfInitialized(); IsValid(AssetManager) && InventoryAsset.IsValid())
+	{
+		FAssetData AssetData;
+		AssetManager->GetPrimaryAssetData(InventoryAsset, AssetData);
+		if (AssetData.IsValid())
+		{
+			ItemDropAssetInfo.bIsValid = true;
+			AssetData.GetTagValue(GET_MEMBER_NAME_CHECKED(UItemDataAsset, bCanStack), ItemDropAssetInfo.bCanStack);
+			ItemDropAssetInfos.Add(InventoryAsset, ItemDropAssetInfo);
+		}
+	}
+
+	return ItemDropAssetInfo;
+}
+
+FVector UItemDropSubsystem::GetScatterOffset(const EItemDropScatterPattern Pattern, const int Index, const int Count, const float Radius)
+{
+	switch (Pattern)
+	{
+	case EItemDropScatterPattern::Circle:
+		{
+			const float Angle = 2.f * UE_PI * Index / FMath::Max(Count, 1);
+			return FVector(FMath::Cos(Angle) * Radius, FMath::Sin(Angle) * Radius, 0.f);
+		}
+	case EItemDropScatterPattern::Spiral:
+		{
+			// Golden angle spiral. Every drop covers the same area of the disc
+			const float Distance = Radius * FMath::Sqrt((Index + 0.5f) / FMath::Max(Count, 1));
+			const float Angle = Index * 2.39996323f;
+			return FVector(FMath::Cos(Angle) * Distance, FMath::Sin(Angle) * Distance, 0.f);
+		}
+	case EItemDropScatterPattern::Random:
+		{
+			const FVector2D Point = FMath::RandPointInCircle(Radius);
+			return FVector(Point.X, Point.Y, 0.f);
+		}
+	default:
+		return FVector::ZeroVector;
+	}
+}
+
+int UItemDropSubsystem::SpawnItemDrops(const TSubclassOf<AItemDrop> ItemDropClass, const TArray<FItemDropSpawnEntry>& Entries, const FTransform& Origin, const EItemDropScatterPattern Pattern, const float ScatterRadius)
+{
+	const UWorld* World = GetWorld();
+	if (!IsValid(ItemDropClass) || ItemDropClass->HasAnyClassFlags(CLASS_Abstract) || !IsValid(World) || World->GetNetMode() == NM_Client)
+	{
+		UE_LOG(InventorySystem, Error, TEXT("[UItemDropSubsystem|%s][SpawnItemDrops]: ItemDropClass is invalid or world has no authority"), *GetFName().ToString());
+		return INDEX_NONE;
+	}
+
+	const int StackSize = FMath::Max(ItemDropClass->GetDefaultObject<AItemDrop>()->GetStackSizeConfig(), 1);
+
+	FItemDropSpawnBatch Batch;
+	Batch.ItemDropClass = ItemDropClass;
+	for (const FItemDropSpawnEntry& Entry : Entries)
+	{
+		const FItemDropAssetInfo ItemDropAssetInfo = GetItemDropAssetInfo(Entry.InventoryAsset);
+		if (!ItemDropAssetInfo.bIsValid || Entry.Amount <= 0)
+		{
+			UE_LOG(InventorySystem, Warning, TEXT("[UItemDropSubsystem|%s][SpawnItemDrops]: Item data or amount invalid. Entry %s skipped"), *GetFName().ToString(), *Entry.InventoryAsset.ToString());
+			continue;
+		}
+
+		// Split the amount into full stacks, or single drops for items that can not stack
+		const int DropStackSize = ItemDropAssetInfo.bCanStack ? StackSize : 1;
+		for (int RemainingAmount = Entry.Amount; RemainingAmount > 0; RemainingAmount -= DropStackSize)
+		{
+			FItemDropSpawnRequest& Request = Batch.Requests.AddDefaulted_GetRef();
+			Request.Entry = Entry;
+			Request.Entry.Amount = FMath::Min(RemainingAmount, DropStackSize);
+			Request.bCanStack = ItemDropAssetInfo.bCanStack;
+		}
+	}
+
+	if (Batch.Requests.IsEmpty())
+	{
+		return INDEX_NONE;
+	}
+
+	for (int Index = 0; Index < Batch.Requests.Num(); Index++)
+	{
+		Batch.Requests[Index].Transform = FTransform(Origin.GetRotation(), Origin.TransformPosition(GetScatterOffset(Pattern, Index, Batch.Requests.Num(), ScatterRadius)), Origin.GetScale3D());
+	}
+
+	Batch.Id = NextSpawnBatchId++;
+	Batch.ItemDrops.Reserve(Batch.Requests.Num());
+	const int BatchId = Batch.Id;
+	SpawnBatches.Add(MoveTemp(Batch));
+
+	// Small batches are done right away, larger ones continue in the next frames
+	if (SpawnBatches.Num() == 1 && !bIsProcessingSpawnBatches)
+	{
+		ProcessSpawnBatches();
+	}
+
+	return BatchId;
+}
+
+void UItemDropSubsystem::ProcessSpawnBatches()
+{
+	const double EndTime = FPlatformTime::Seconds() + SpawnBudget;
+	bIsProcessingSpawnBatches = true;
+
+	// At least one drop per frame, so batches always finish
+	bool bIsFirst = true;
+	while (!SpawnBatches.IsEmpty() && (bIsFirst || FPlatformTime::Seconds() < EndTime))
+	{
+		bIsFirst = false;
+
+		// BeginPlay of a drop can add batches, so the batch is accessed by index again after spawning
+		const TSubclassOf<AItemDrop> ItemDropClass = SpawnBatches[0].ItemDropClass;
+		const FItemDropSpawnRequest Request = SpawnBatches[0].Requests[SpawnBatches[0].NextRequest++];
+		if (AItemDrop* ItemDrop = SpawnItemDropInternal(ItemDropClass, Request.Entry.InventoryAsset, Request.Entry.Amount, Request.Entry.DynamicStats, Request.Transform, true, Request.bCanStack))
+		{
+			SpawnBatches[0].ItemDrops.Add(ItemDrop);
+		}
+
+		if (SpawnBatches[0].NextRequest < SpawnBatches[0].Requests.Num())
+		{
+			continue;
+		}
+
+		FItemDropSpawnBatch FinishedBatch = MoveTemp(SpawnBatches[0]);
+		SpawnBatches.RemoveAt(0);
+
+		TArray<AItemDrop*> ItemDrops;
+		ItemDrops.Reserve(FinishedBatch.ItemDrops.Num());
+		for (const TWeakObjectPtr<AItemDrop>& ItemDrop : FinishedBatch.ItemDrops)
+		{
+			if (ItemDrop.IsValid())
+			{
+				ItemDrops.Add(ItemDrop.Get());
+			}
+		}
+		ItemDropsSpawnedDelegate.Broadcast(FinishedBatch.Id, ItemDrops);
+	}
+
+	bIsProcessingSpawnBatches = false;
+	if (!SpawnBatches.IsEmpty())
+	{
+		GetWorld()->GetTimerManager().SetTimerForNextTick(FTimerDelegate::CreateUObject(this, &UItemDropSubsystem::ProcessSpawnBatches));
+	}
+}
+
+bool UItemDropSubsystem::CanMerge(const AItemDrop* ItemDrop)
+{
+	return IsValid(ItemDrop) && !ItemDrop->IsActorBeingDestroyed() && !ItemDrop->IsPooled() && !ItemDrop->IsProcessing() && ItemDrop->CanStack() && ItemDrop->Amount > 0;
+}
+
+void UItemDropSubsystem::MergePendingItemDrops()
+{
+	TArray<TWeakObjectPtr<AItemDrop>> ItemDrops = MoveTemp(PendingMergeItemDrops);
+	PendingMergeItemDrops.Reset();
+
+	for (const TWeakObjectPtr<AItemDrop>& ItemDrop : ItemDrops)
+	{
+		MergeItemDrop(ItemDrop.Get(), MergeRadius);
+	}
+}
+
+bool UItemDropSubsystem::MergeItemDrop(AItemDrop* ItemDrop, const float Radius)
+{
+	if (!CanMerge(ItemDrop) || ItemDrop->GetNetMode() == NM_Client)
+	{
+		return false;
+	}
+
+	FItemDropQuery Query;
+	Query.Asset = ItemDrop->InventoryAsset;
+	Query.StackFilter = EItemDropStackFilter::Stackable;
+
+	bool bIsChanged = false;
+	for (AItemDrop* OtherItemDrop : GetItemDropsInRadius(ItemDrop->GetActorLocation(), Radius, Query))
+	{
+		// Different classes can have a different stack size or pick up behavior
+		if (OtherItemDrop == ItemDrop || !CanMerge(OtherItemDrop) || OtherItemDrop->GetClass() != ItemDrop->GetClass() || !(OtherItemDrop->DynamicStats == ItemDrop->DynamicStats))
+		{
+			continue;
+		}
+
+		const int MovedAmount = FMath::Min(ItemDrop->Amount, OtherItemDrop->GetStackSizeConfig() - OtherItemDrop->Amount);
+		if (MovedAmount <= 0)
+		{
+			continue;
+		}
+
+		OtherItemDrop->Amount += MovedAmount;
+		OtherItemDrop->FlushItemData();
+		ItemDrop->Amount -= MovedAmount;
+		bIsChanged = true;
+		if (ItemDrop->Amount <= 0)
+		{
+			ReleaseItemDrop(ItemDrop);
+			return true;
+		}
+	}
+
+	if (bIsChanged)
+	{
+		ItemDrop->FlushItemData();
+	}
+
+	return false;
+}
+
+int UItemDropSubsystem::MergeItemDropsInRadius(const FVector& Location, const float Radius, const float ItemDropMergeRadius)
+{
+	FItemDropQuery Query;
+	Query.StackFilter = EItemDropStackFilter::Stackable;
+
+	int EmptiedCount = 0;
+	for (AItemDrop* ItemDrop : GetItemDropsInRadius(Location, Radius, Query))
+	{
+		// Drops emptied by this pass are already pooled and skipped by MergeItemDrop
+		if (MergeItemDrop(ItemDrop, ItemDropMergeRadius))
+		{
+			EmptiedCount++;
+		}
+	}
+
+	return EmptiedCount;
+}
+
+FIntVector UItemDropSubsystem::GetRegion(const FVector& Location) const
+{
+	return FIntVector(FMath::FloorToInt(Location.X / RegionSize), FMath::FloorToInt(Location.Y / RegionSize), FMath::FloorToInt(Location.Z / RegionSize));
+}
+
+bool UItemDropSubsystem::MatchesQuery(const FItemDropInstance& ItemDropInstance, const FItemDropQuery& Query) const
+{
+	if (ItemDropInstance.Amount <= 0)
+	{
+		return false;
+	}
+
+	if (Query.Asset.IsValid() && ItemDropInstance.InventoryAsset != Query.Asset)
+	{
+		return false;
+	}
+
+	switch (Query.StackFilter)
+	{
+	case EItemDropStackFilter::Stackable:
+		return GetItemDropAssetInfo(ItemDropInstance.InventoryAsset).bCanStack;
+	case EItemDropStackFilter::NotStackable:
+		return !GetItemDropAssetInfo(ItemDropInstance.InventoryAsset).bCanStack;
+	default:
+		return true;
+	}
+}
+
+void UItemDropSubsystem::RegisterItemDropRegion(AItemDropRegion* ItemDropRegion)
+{
+	if (IsValid(ItemDropRegion))
+	{
+		ItemDropRegions.Add(GetRegion(ItemDropRegion->GetActorLocation()), ItemDropRegion);
+	}
+}
+
+void UItemDropSubsystem::UnregisterItemDropRegion(const AItemDropRegion* ItemDropRegion)
+{
+	const FIntVector Region = GetRegion(ItemDropRegion->GetActorLocation());
+	if (const TWeakObjectPtr<AItemDropRegion>* RegisteredItemDropRegion = ItemDropRegions.Find(Region); RegisteredItemDropRegion != nullptr && RegisteredItemDropRegion->Get() == ItemDropRegion)
+	{
+		ItemDropRegions.Remove(Region);
+	}
+}
+
+int UItemDropSubsystem::AddLightweightItemDrop(const FPrimaryAssetId& InventoryAsset, const int Amount, const FItemProperties& DynamicStats, const FTransform& Transform)
+{
+	UWorld* World = GetWorld();
+	const FItemDropAssetInfo ItemDropAssetInfo = GetItemDropAssetInfo(InventoryAsset);
+	if (!ItemDropAssetInfo.bIsValid || Amount <= 0 || !IsValid(World) || World->GetNetMode() == NM_Client)
+	{
+		UE_LOG(InventorySystem, Error, TEXT("[UItemDropSubsystem|%s][AddLightweightItemDrop]: Item data or amount invalid or world has no authority"), *GetFName().ToString());
+		return INDEX_NONE;
+	}
+
+	const UInventorySystemSettings* InventorySettings = GetMutableDefault<UInventorySystemSettings>();
+	const TSubclassOf<AItemDrop> ItemDropClass = InventorySettings->LightweightItemDropClass.LoadSynchronous();
+	if (!IsValid(ItemDropClass))
+	{
+		UE_LOG(InventorySystem, Error, TEXT("[UItemDropSubsystem|%s][AddLightweightItemDrop]: LightweightItemDropClass is not set"), *GetFName().ToString());
+		return INDEX_NONE;
+	}
+
+	const FIntVector Region = GetRegion(Transform.GetLocation());
+	AItemDropRegion* ItemDropRegion = ItemDropRegions.FindRef(Region).Get();
+	if (!IsValid(ItemDropRegion))
+	{
+		const FVector RegionLocation = (FVector(Region) + FVector(0.5)) * RegionSize;
+		FActorSpawnParameters SpawnParameters;
+		SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+		ItemDropRegion = World->SpawnActor<AItemDropRegion>(AItemDropRegion::StaticClass(), RegionLocation, FRotator::ZeroRotator, SpawnParameters);
+		if (!IsValid(ItemDropRegion))
+		{
+			UE_LOG(InventorySystem, Error, TEXT("[UItemDropSubsystem|%s][AddLightweightItemDrop]: Unable to spawn ItemDropRegion"), *GetFName().ToString());
+			return INDEX_NONE;
+		}
+		ItemDropRegions.Add(Region, ItemDropRegion);
+	}
+
+	// Promoted drops keep their amount, so split it the same way SpawnItemDrops does
+	const int StackSize = ItemDropAssetInfo.bCanStack ? FMath::Max(ItemDropClass->GetDefaultObject<AItemDrop>()->GetStackSizeConfig(), 1) : 1;
+	const float Lifetime = GetItemDropLifetime(InventoryAsset);
+	int FirstId = INDEX_NONE;
+	for (int RemainingAmount = Amount; RemainingAmount > 0; RemainingAmount -= StackSize)
+	{
+		FItemDropInstance ItemDropInstance;
+		ItemDropInstance.Id = NextItemDropInstanceId++;
+		ItemDropInstance.InventoryAsset = InventoryAsset;
+		ItemDropInstance.Amount = FMath::Min(RemainingAmount, StackSize);
+		ItemDropInstance.DynamicStats = DynamicStats;
+		ItemDropInstance.Transform = Transform;
+
+		ItemDropRegion->AddItemDropInstance(ItemDropInstance);
+		ItemDropRegionById.Add(ItemDropInstance.Id, Region);
+		ScheduleLightweightItemDropDespawn(ItemDropInstance.Id, Lifetime);
+
+		if (FirstId == INDEX_NONE)
+		{
+			FirstId = ItemDropInstance.Id;
+		}
+	}
+
+	return FirstId;
+}
+
+bool UItemDropSubsystem::RemoveLightweightItemDrop(const int Id, FItemDropInstance& OutItemDropInstance)
+{
+	FIntVector Region;
+	if (!ItemDropRegionById.RemoveAndCopyValue(Id, Region))
+	{
+		return false;
+	}
+
+	DespawnTickByLightweightId.Remove(Id);
+
+	AItemDropRegion* ItemDropRegion = ItemDropRegions.FindRef(Region).Get();
+	if (!IsValid(ItemDropRegion) || !ItemDropRegion->RemoveItemDropInstance(Id, OutItemDropInstance))
+	{
+		return false;
+	}
+
+	// Empty regions close their actor channel
+	if (ItemDropRegion->GetItemDropInstances().IsEmpty())
+	{
+		ItemDropRegions.Remove(Region);
+		ItemDropRegion->Destroy();
+	}
+
+	return true;
+}
+
+bool UItemDropSubsystem::FindLightweightItemDrop(const int Id, FItemDropInstance& OutItemDropInstance) const
+{
+	const FIntVector* Region = ItemDropRegionById.Find(Id);
+	const AItemDropRegion* ItemDropRegion = Region != nullptr ? ItemDropRegions.FindRef(*Region).Get() : nullptr;
+	const FItemDropInstance* FoundItemDropInstance = IsValid(ItemDropRegion) ? ItemDropRegion->FindItemDropInstance(Id) : nullptr;
+	if (FoundItemDropInstance == nullptr)
+	{
+		return false;
+	}
+
+	OutItemDropInstance = *FoundItemDropInstance;
+	return true;
+}
+
+AItemDrop* UItemDropSubsystem::PromoteLightweightItemDrop(const int Id)
+{
+	const UInventorySystemSettings* InventorySettings = GetMutableDefault<UInventorySystemSettings>();
+	const TSubclassOf<AItemDrop> ItemDropClass = InventorySettings->LightweightItemDropClass.LoadSynchronous();
+	if (!IsValid(ItemDropClass))
+	{
+		UE_LOG(InventorySystem, Error, TEXT("[UItemDropSubsystem|%s][PromoteLightweightItemDrop]: LightweightItemDropClass is not set"), *GetFName().ToString());
+		return nullptr;
+	}
+
+	// Copy before spawning. The drop data was validated when it was added, so the spawn must not clamp or roll the amount again
+	FItemDropInstance ItemDropInstance;
+	if (!FindLightweightItemDrop(Id, ItemDropInstance))
+	{
+		return nullptr;
+	}
+
+	const FItemDropAssetInfo ItemDropAssetInfo = GetItemDropAssetInfo(ItemDropInstance.InventoryAsset);
+	AItemDrop* ItemDrop = SpawnItemDropInternal(ItemDropClass, ItemDropInstance.InventoryAsset, ItemDropInstance.Amount, ItemDropInstance.DynamicStats, ItemDropInstance.Transform, ItemDropAssetInfo.bIsValid, ItemDropAssetInfo.bCanStack);
+	if (!IsValid(ItemDrop))
+	{
+		UE_LOG(InventorySystem, Error, TEXT("[UItemDropSubsystem|%s][PromoteLightweightItemDrop]: Unable to spawn ItemDrop. Lightweight drop %d kept"), *GetFName().ToString(), Id);
+		return nullptr;
+	}
+
+	FItemDropInstance RemovedItemDropInstance;
+	RemoveLightweightItemDrop(Id, RemovedItemDropInstance);
+	return ItemDrop;
+}
+
+TArray<FItemDropInstance> UItemDropSubsystem::GetLightweightItemDropsInRadius(const FVector& Location, const float Radius, const FItemDropQuery& Query) const
+{
+	TArray<FItemDropInstance> Result;
+	if (Radius < 0.f)
+	{
+		return Result;
+	}
+
+	const double RadiusSquared = FMath::Square(static_cast<double>(Radius));
+	const FIntVector MinRegion = GetRegion(Location - FVector(Radius));
+	const FIntVector MaxRegion = GetRegion(Location + FVector(Radius));
+	for (const TPair<FIntVector, TWeakObjectPtr<AItemDropRegion>>& ItemDropRegion : ItemDropRegions)
+	{
+		const FIntVector& Region = ItemDropRegion.Key;
+		if (Region.X < MinRegion.X || Region.X > MaxRegion.X || Region.Y < MinRegion.Y || Region.Y > MaxRegion.Y || Region.Z < MinRegion.Z || Region.Z > MaxRegion.Z || !ItemDropRegion.Value.IsValid())
+		{
+			continue;
+		}
+
+		for (const FItemDropInstance& ItemDropInstance : ItemDropRegion.Value->GetItemDropInstances())
+		{
+			if (FVector::DistSquared(ItemDropInstance.Transform.GetLocation(), Location) <= RadiusSquared && MatchesQuery(ItemDropInstance, Query))
+			{
+				Result.Add(ItemDropInstance);
+			}
+		}
+	}
+
+	return Result;
+}
+
+int UItemDropSubsystem::GetLightweightItemDropCount() const
+{
+	return ItemDropRegionById.Num();
+}
+
+float UItemDropSubsystem::GetItemDropLifetime(const FPrimaryAssetId& InventoryAsset)
+{
+	const UInventorySystemSettings* InventorySettings = GetMutableDefault<UInventorySystemSettings>();
+	if (const float* Lifetime = InventorySettings->ItemDropLifetimes.Find(InventoryAsset))
+	{
+		return FMath::Max(*Lifetime, 0.f);
+	}
+
+	return FMath::Max(InventorySettings->ItemDropLifetime, 0.f);
+}
+
+uint64 UItemDropSubsystem::GetDespawnExpireTick(const float Lifetime)
+{
+	if (!GetWorld()->GetTimerManager().IsTimerActive(DespawnTimerHandle))
+	{
+		GetWorld()->GetTimerManager().SetTimer(DespawnTimerHandle, FTimerDelegate::CreateUObject(this, &UItemDropSubsystem::AdvanceDespawnWheel), DespawnTickInterval, true);
+	}
+
+	// Never expire in the current tick, its slot was already processed
+	return DespawnTick + FMath::Max<uint64>(FMath::CeilToInt64(Lifetime / DespawnTickInterval), 1);
+}
+
+void UItemDropSubsystem::ScheduleItemDropDespawn(AItemDrop* ItemDrop, const float Lifetime)
+{
+	if (!IsValid(ItemDrop) || ItemDrop->GetNetMode() == NM_Client)
+	{
+		return;
+	}
+
+	if (Lifetime <= 0.f)
+	{
+		DespawnTickByDrop.Remove(ItemDrop);
+		return;
+	}
+
+	FItemDropDespawnEntry Entry;
+	Entry.ItemDrop = ItemDrop;
+	Entry.ExpireTick = GetDespawnExpireTick(Lifetime);
+	DespawnTickByDrop.Add(ItemDrop, Entry.ExpireTick);
+	AddDespawnEntry(MoveTemp(Entry));
+}
+
+void UItemDropSubsystem::ScheduleLightweightItemDropDespawn(const int Id, const float Lifetime)
+{
+	if (!ItemDropRegionById.Contains(Id))
+	{
+		return;
+	}
+
+	if (Lifetime <= 0.f)
+	{
+		DespawnTickByLightweightId.Remove(Id);
+		return;
+	}
+
+	FItemDropDespawnEntry Entry;
+	Entry.LightweightId = Id;
+	Entry.ExpireTick = GetDespawnExpireTick(Lifetime);
+	DespawnTickByLightweightId.Add(Id, Entry.ExpireTick);
+	AddDespawnEntry(MoveTemp(Entry));
+}
+
+int UItemDropSubsystem::GetScheduledDespawnCount() const
+{
+	return DespawnTickByDrop.Num() + DespawnTickByLightweightId.Num();
+}
+
+void UItemDropSubsystem::AddDespawnEntry(FItemDropDespawnEntry&& Entry)
+{
+	// The level is chosen by the distance to the expire tick, the slot by the bits of the expire tick of that level
+	const uint64 Delta = Entry.ExpireTick - DespawnTick;
+	int Level = 0;
+	while (Level < DespawnWheelLevels - 1 && Delta >= 1ull << (DespawnWheelSlotBits * (Level + 1)))
+	{
+		Level++;
+	}
+
+	// Lifetimes beyond the highest level wait in its furthest slot and are sorted in again when it cascades
+	const uint64 SlotTick = FMath::Min(Entry.ExpireTick, DespawnTick + (1ull << (DespawnWheelSlotBits * DespawnWheelLevels)) - 1);
+	const int Slot = static_cast<int>((SlotTick >> (DespawnWheelSlotBits * Level)) & (DespawnWheelSlots - 1));
+	DespawnWheel[Level * DespawnWheelSlots + Slot].Add(MoveTemp(Entry));
+}
+
+void UItemDropSubsystem::AdvanceDespawnWheel()
+{
+	DespawnTick++;
+
+	// Move the entries of higher levels down whenever the level below wrapped around
+	for (int Level = 1; Level < DespawnWheelLevels; Level++)
+	{
+		if ((DespawnTick & ((1ull << (DespawnWheelSlotBits * Level)) - 1)) != 0)
+		{
+			break;
+		}
+
+		const int Slot = static_cast<int>((DespawnTick >> (DespawnWheelSlotBits * Level)) & (DespawnWheelSlots - 1));
+		TArray<FItemDropDespawnEntry> Entries = MoveTemp(DespawnWheel[Level * DespawnWheelSlots + Slot]);
+		DespawnWheel[Level * DespawnWheelSlots + Slot].Reset();
+		for (FItemDropDespawnEntry& Entry : Entries)
+		{
+			AddDespawnEntry(MoveTemp(Entry));
+		}
+	}
+
+	const int Slot = static_cast<int>(DespawnTick & (DespawnWheelSlots - 1));
+	TArray<FItemDropDespawnEntry> Entries = MoveTemp(DespawnWheel[Slot]);
+	DespawnWheel[Slot].Reset();
+	for (FItemDropDespawnEntry& Entry : Entries)
+	{
+		if (Entry.ExpireTick > DespawnTick)
+		{
+			AddDespawnEntry(MoveTemp(Entry));
+			continue;
+		}
+
+		if (Entry.LightweightId != INDEX_NONE)
+		{
+			// Outdated if the drop was removed or rescheduled
+			if (const uint64* ExpireTick = DespawnTickByLightweightId.Find(Entry.LightweightId); ExpireTick != nullptr && *ExpireTick == Entry.ExpireTick)
+			{
+				FItemDropInstance ItemDropInstance;
+				RemoveLightweightItemDrop(Entry.LightweightId, ItemDropInstance);
+			}
+			continue;
+		}
+
+		AItemDrop* ItemDrop = Entry.ItemDrop.Get();
+		const uint64* ExpireTick = DespawnTickByDrop.Find(ItemDrop);
+		if (!IsValid(ItemDrop) || ExpireTick == nullptr || *ExpireTick != Entry.ExpireTick)
+		{
+			continue;
+		}
+
+		// Try again next tick instead of removing a drop during a pick up
+		if (ItemDrop->IsProcessing())
+		{
+			ScheduleItemDropDespawn(ItemDrop, DespawnTickInterval);
+			continue;
+		}
+
+		DespawnTickByDrop.Remove(ItemDrop);
+		ReleaseItemDrop(ItemDrop);
+	}
+}
+
+#undef LOCTEXT_NAMESPACE
@@ -17,15 +17,31 @@ UInventorySystemSettings::UInventorySystemSettings(const FObjectInitializer& OBJ
 	MaxInventoryStackSize = 99;
 	MaxInventorySize = 200;
 	MaxItemEquipmentStackSize = 99;
+	MaxEquipmentSlot = 255;
 	MaxItemContainerStackSize = 99;
 	MaxItemContainerSize = 20;
 	MaxItemDropStackSize = 99;
+	ItemDropGridCellSize = 1000.f;
+	ItemDropPoolSize = 64;
+	bMergeItemDrops = false;
+	ItemDropMergeRadius = 200.f;
+	MaxItemDropPickUpRadius = 500.f;
+	ItemDropLifetime = 0.f;
+	ItemDropSpawnBudget = 1.f;
+	LightweightItemDropRegionSize = 10000.f;
+	LightweightItemDropNetCullDistance = 15000.f;
 }
 
 #if WITH_EDITORONLY_DATA
 void UInventorySystemSettings::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
 {
 	UObject::PostEditChangeProperty(PropertyChangedEvent);
+
+	// Indexed properties are only read at runtime. No assets need to be saved again
+	if (PropertyChangedEvent.GetMemberPropertyName() == GET_MEMBER_NAME_CHECKED(UInventorySystemSettings, IndexedPropertyNames))
+	{
+		return;
+	}
 	
 	const FAssetRegistryModule& AssetRegistryModule = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry");
 
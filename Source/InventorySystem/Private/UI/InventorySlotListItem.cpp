@@ -0,0 +1,30 @@
+﻿// © 2024 Daniel Münch. All Rights Reserved
+
+#include "UI/InventorySlotListItem.h"
+
+#include "ItemContainerComponent.h"
+
+#define LOCTEXT_NAMESPACE "InventorySystem"
+
+void UInventorySlotListItem::SetInventorySlot(UItemContainerComponent* NewItemContainerComponent, const int NewInventorySlot)
+{
+	ItemContainerComponent = NewItemContainerComponent;
+	InventorySlot = NewInventorySlot;
+}
+
+UItemContainerComponent* UInventorySlotListItem::GetItemContainerComponent() const
+{
+	return ItemContainerComponent.Get();
+}
+
+FInventorySlot UInventorySlotListItem::GetInventorySlotData() const
+{
+	if (const UItemContainerComponent* Component = ItemContainerComponent.Get(); IsValid(Component))
+	{
+		return Component->GetInventorySlot(InventorySlot);
+	}
+
+	return FInventorySlot{};
+}
+
+#undef LOCTEXT_NAMESPACE
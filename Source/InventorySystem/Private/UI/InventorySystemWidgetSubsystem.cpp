@@ -0,0 +1,122 @@
+﻿// © 2024 Daniel Münch. All Rights Reserved
+
+#include "UI/InventorySystemWidgetSubsystem.h"
+
+#include "InventorySystemComponent.h"
+#include "Engine/LocalPlayer.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerController.h"
+#include "GameFramework/PlayerState.h"
+
+#define LOCTEXT_NAMESPACE "InventorySystem"
+
+UInventorySystemWidgetSubsystem* UInventorySystemWidgetSubsystem::Get(const APlayerController* PlayerController)
+{
+	if (!IsValid(PlayerController))
+	{
+		return nullptr;
+	}
+
+	if (const ULocalPlayer* LocalPlayer = PlayerController->GetLocalPlayer(); IsValid(LocalPlayer))
+	{
+		return LocalPlayer->GetSubsystem<UInventorySystemWidgetSubsystem>();
+	}
+
+	return nullptr;
+}
+
+void UInventorySystemWidgetSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	ComponentReadyHandle = UItemContainerComponent::ItemContainerComponentReadyDelegate.AddUObject(this, &UInventorySystemWidgetSubsystem::HandleComponentReady);
+}
+
+void UInventorySystemWidgetSubsystem::Deinitialize()
+{
+	UItemContainerComponent::ItemContainerComponentReadyDelegate.Remove(ComponentReadyHandle);
+	ComponentReadyHandle.Reset();
+
+	Super::Deinitialize();
+}
+
+void UInventorySystemWidgetSubsystem::UpdateResolvedComponents(const APlayerController* PlayerController)
+{
+	if (!IsValid(PlayerController))
+	{
+		return;
+	}
+
+	APlayerState* PlayerState = PlayerController->GetPlayerState<APlayerState>();
+	APawn* Pawn = PlayerController->GetPawn();
+
+	// A PlayerState accepted by HandleComponentReady is kept until the player controller points to a PlayerState
+	const bool bIsSamePlayerState = PlayerState == CachedPlayerState.Get() || (PlayerState == nullptr && CachedPlayerState.IsValid());
+	if (bIsResolved && bIsSamePlayerState && Pawn == CachedPawn.Get())
+	{
+		return;
+	}
+
+	ResolveComponents(IsValid(PlayerState) ? PlayerState : CachedPlayerState.Get(), Pawn);
+}
+
+void UInventorySystemWidgetSubsystem::ResolveComponents(APlayerState* PlayerState, APawn* Pawn)
+{
+	UItemContainerComponent* ItemContainerComponent = nullptr;
+	UInventorySystemComponent* InventorySystemComponent = nullptr;
+	if (IsValid(PlayerState))
+	{
+		ItemContainerComponent = PlayerState->FindComponentByClass<UItemContainerComponent>();
+		InventorySystemComponent = PlayerState->FindComponentByClass<UInventorySystemComponent>();
+	}
+
+	const bool bHasChanged = ItemContainerComponent != CachedItemContainerComponent.Get() || InventorySystemComponent != CachedInventorySystemComponent.Get();
+
+	CachedPlayerState = PlayerState;
+	CachedPawn = Pawn;
+	CachedItemContainerComponent = ItemContainerComponent;
+	CachedInventorySystemComponent = InventorySystemComponent;
+	bIsResolved = true;
+
+	if (bHasChanged)
+	{
+		ResolvedPlayerComponentsChangedDelegate.Broadcast();
+	}
+}
+
+UItemContainerComponent* UInventorySystemWidgetSubsystem::GetItemContainerComponent(const APlayerController* PlayerController)
+{
+	UpdateResolvedComponents(PlayerController);
+	return CachedItemContainerComponent.Get();
+}
+
+UInventorySystemComponent* UInventorySystemWidgetSubsystem::GetInventorySystemComponent(const APlayerController* PlayerController)
+{
+	UpdateResolvedComponents(PlayerController);
+	return CachedInventorySystemComponent.Get();
+}
+
+void UInventorySystemWidgetSubsystem::HandleComponentReady(UItemContainerComponent* Component)
+{
+	const ULocalPlayer* LocalPlayer = GetLocalPlayer();
+	const APlayerController* PlayerController = IsValid(LocalPlayer) ? LocalPlayer->GetPlayerController(LocalPlayer->GetWorld()) : nullptr;
+	if (!IsValid(PlayerController) || !IsValid(Component))
+	{
+		return;
+	}
+
+	APlayerState* PlayerState = Cast<APlayerState>(Component->GetOwner());
+	if (!IsValid(PlayerState) || (PlayerController->GetPlayerState<APlayerState>() != PlayerState && PlayerState->GetPlayerController() != PlayerController))
+	{
+		return;
+	}
+
+	ResolveComponents(PlayerState, PlayerController->GetPawn());
+}
+
+void UInventorySystemWidgetSubsystem::InvalidateResolvedComponents()
+{
+	bIsResolved = false;
+}
+
+#undef LOCTEXT_NAMESPACE
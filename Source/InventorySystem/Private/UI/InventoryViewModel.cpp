@@ -0,0 +1,279 @@
+﻿// © 2024 Daniel Münch. All Rights Reserved
+
+#include "UI/InventoryViewModel.h"
+
+#include "Algo/BinarySearch.h"
+
+#define LOCTEXT_NAMESPACE "InventorySystem"
+
+void UInventoryViewModel::BeginDestroy()
+{
+	if (UItemContainerComponent* Component = ItemContainerComponent.Get())
+	{
+		Component->ChangedInventorySlotsDelegate.RemoveDynamic(this, &UInventoryViewModel::HandleChangedInventorySlots);
+	}
+
+	Super::BeginDestroy();
+}
+
+void UInventoryViewModel::SetItemContainerComponent(UItemContainerComponent* NewItemContainerComponent)
+{
+	if (UItemContainerComponent* Component = ItemContainerComponent.Get())
+	{
+		Component->ChangedInventorySlotsDelegate.RemoveDynamic(this, &UInventoryViewModel::HandleChangedInventorySlots);
+	}
+
+	ItemContainerComponent = NewItemContainerComponent;
+	if (IsValid(NewItemContainerComponent))
+	{
+		NewItemContainerComponent->ChangedInventorySlotsDelegate.AddDynamic(this, &UInventoryViewModel::HandleChangedInventorySlots);
+	}
+
+	RebuildRows();
+}
+
+void UInventoryViewModel::SetSort(const EItemContainerSortKey NewSortKey, const FName PropertyName, const bool bDescending)
+{
+	SortKey = NewSortKey;
+	SortPropertyName = PropertyName;
+	bSortDescending = bDescending;
+	RebuildRows();
+}
+
+void UInventoryViewModel::SetFilterText(const FString& NewFilterText)
+{
+	FilterText = NewFilterText.TrimStartAndEnd();
+	RebuildRows();
+}
+
+int UInventoryViewModel::GetRowCount() const
+{
+	return Rows.Num();
+}
+
+int UInventoryViewModel::GetRowSlot(const int Row) const
+{
+	return Rows.IsValidIndex(Row) ? Rows[Row] : INDEX_NONE;
+}
+
+int UInventoryViewModel::GetSlotRow(const int Slot) const
+{
+	return FindRow(Slot);
+}
+
+TArray<int> UInventoryViewModel::GetRows() const
+{
+	return Rows;
+}
+
+UInventoryViewModel::FInventoryViewRowKey UInventoryViewModel::MakeRowKey(const FInventorySlot& InventorySlot) const
+{
+	FInventoryViewRowKey RowKey;
+	RowKey.Slot = InventorySlot.Slot;
+	RowKey.AssetName = InventorySlot.Asset.ToString();
+	RowKey.Amount = InventorySlot.Amount;
+
+	if (SortKey != EItemContainerSortKey::PropertyValue)
+	{
+		return RowKey;
+	}
+
+	for (const FItemProperty& ItemProperty : InventorySlot.ItemProperties.ItemProperties)
+	{
+		if (ItemProperty.Name == SortPropertyName)
+		{
+			RowKey.bHasProperty = true;
+			RowKey.bIsNumeric = ItemProperty.Value.IsNumeric();
+			RowKey.TextValue = ItemProperty.Value.ToString();
+			RowKey.NumericValue = RowKey.bIsNumeric ? FCString::Atod(*RowKey.TextValue) : 0.0;
+			break;
+		}
+	}
+
+	return RowKey;
+}
+
+bool UInventoryViewModel::PassesFilter(const FInventorySlot& InventorySlot) const
+{
+	if (InventorySlot.Slot == INDEX_NONE || !InventorySlot.Asset.IsValid())
+	{
+		return false;
+	}
+
+	return FilterText.IsEmpty() || InventorySlot.Asset.PrimaryAssetName.ToString().Contains(FilterText, ESearchCase::IgnoreCase);
+}
+
+bool UInventoryViewModel::IsRowBefore(const FInventoryViewRowKey& First, const FInventoryViewRowKey& Second) const
+{
+	int Result = 0;
+	switch (SortKey)
+	{
+	case EItemContainerSortKey::PropertyValue:
+		// Items without the property are always placed last, numeric values before text values
+		if (First.bHasProperty != Second.bHasProperty)
+		{
+			return First.bHasProperty;
+		}
+
+		if (First.bIsNumeric != Second.bIsNumeric)
+		{
+			return First.bIsNumeric;
+		}
+
+		if (First.bIsNumeric)
+		{
+			Result = First.NumericValue < Second.NumericValue ? -1 : (First.NumericValue > Second.NumericValue ? 1 : 0);
+		}
+		else
+		{
+			Result = First.TextValue.Compare(Second.TextValue);
+		}
+		break;
+	case EItemContainerSortKey::Amount:
+		Result = First.Amount - Second.Amount;
+		break;
+	default:
+		Result = First.AssetName.Compare(Second.AssetName);
+		break;
+	}
+
+	if (Result != 0)
+	{
+		return bSortDescending ? Result > 0 : Result < 0;
+	}
+
+	// Same tie breakers as SortItems: asset, bigger stacks first, slot
+	if (const int AssetResult = First.AssetName.Compare(Second.AssetName); AssetResult != 0)
+	{
+		return AssetResult < 0;
+	}
+
+	if (First.Amount != Second.Amount)
+	{
+		return First.Amount > Second.Amount;
+	}
+
+	return First.Slot < Second.Slot;
+}
+
+int UInventoryViewModel::FindRow(const int Slot) const
+{
+	const FInventoryViewRowKey* RowKey = RowKeys.Find(Slot);
+	if (RowKey == nullptr)
+	{
+		return INDEX_NONE;
+	}
+
+	const int Row = Algo::LowerBound(Rows, *RowKey, [this](const int RowSlot, const FInventoryViewRowKey& Value)
+	{
+		return IsRowBefore(RowKeys.FindChecked(RowSlot), Value);
+	});
+
+	return Rows.IsValidIndex(Row) && Rows[Row] == Slot ? Row : INDEX_NONE;
+}
+
+void UInventoryViewModel::RebuildRows()
+{
+	const int PreviousRowCount = Rows.Num();
+	Rows.Reset();
+	RowKeys.Reset();
+
+	if (const UItemContainerComponent* Component = ItemContainerComponent.Get(); IsValid(Component))
+	{
+		for (const FInventorySlot& InventorySlot : Component->GetInventorySlots())
+		{
+			if (PassesFilter(InventorySlot))
+			{
+				RowKeys.Add(InventorySlot.Slot, MakeRowKey(InventorySlot));
+				Rows.Add(InventorySlot.Slot);
+			}
+		}
+
+		Rows.Sort([this](const int First, const int Second)
+		{
+			return IsRowBefore(RowKeys.FindChecked(First), RowKeys.FindChecked(Second));
+		});
+	}
+
+	if (const int LastRow = FMath::Max(PreviousRowCount, Rows.Num()) - 1; LastRow >= 0)
+	{
+		InventoryViewRowsChangedDelegate.Broadcast(0, LastRow);
+	}
+}
+
+void UInventoryViewModel::HandleChangedInventorySlots(const TArray<int>& Slots)
+{
+	const UItemContainerComponent* Component = ItemContainerComponent.Get();
+	if (!IsValid(Component))
+	{
+		return;
+	}
+
+	int FirstRow = MAX_int32;
+	int LastRow = INDEX_NONE;
+	const auto MarkRows = [&FirstRow, &LastRow](const int First, const int Last)
+	{
+		FirstRow = FMath::Min(FirstRow, First);
+		LastRow = FMath::Max(LastRow, Last);
+	};
+
+	for (const int Slot : Slots)
+	{
+		const FInventorySlot InventorySlot = Component->GetInventorySlot(Slot);
+		const int OldRow = FindRow(Slot);
+
+		if (!PassesFilter(InventorySlot))
+		{
+			if (OldRow != INDEX_NONE)
+			{
+				// All following rows move up by one
+				Rows.RemoveAt(OldRow);
+				RowKeys.Remove(Slot);
+				MarkRows(OldRow, Rows.Num());
+			}
+			continue;
+		}
+
+		FInventoryViewRowKey RowKey = MakeRowKey(InventorySlot);
+		if (OldRow != INDEX_NONE)
+		{
+			// Keep the row in place if it is still ordered between its neighbours
+			const bool bAfterPrevious = OldRow == 0 || IsRowBefore(RowKeys.FindChecked(Rows[OldRow - 1]), RowKey);
+			const bool bBeforeNext = OldRow == Rows.Num() - 1 || IsRowBefore(RowKey, RowKeys.FindChecked(Rows[OldRow + 1]));
+			if (bAfterPrevious && bBeforeNext)
+			{
+				RowKeys.Add(Slot, MoveTemp(RowKey));
+				MarkRows(OldRow, OldRow);
+				continue;
+			}
+
+			Rows.RemoveAt(OldRow);
+			RowKeys.Remove(Slot);
+		}
+
+		const int NewRow = Algo::LowerBound(Rows, RowKey, [this](const int RowSlot, const FInventoryViewRowKey& Value)
+		{
+			return IsRowBefore(RowKeys.FindChecked(RowSlot), Value);
+		});
+		Rows.Insert(Slot, NewRow);
+		RowKeys.Add(Slot, MoveTemp(RowKey));
+
+		if (OldRow != INDEX_NONE)
+		{
+			// Only the rows between the old and new position moved
+			MarkRows(FMath::Min(OldRow, NewRow), FMath::Max(OldRow, NewRow));
+		}
+		else
+		{
+			// All following rows move down by one
+			MarkRows(NewRow, Rows.Num() - 1);
+		}
+	}
+
+	if (LastRow != INDEX_NONE)
+	{
+		InventoryViewRowsChangedDelegate.Broadcast(FirstRow, LastRow);
+	}
+}
+
+#undef LOCTEXT_NAMESPACE
@@ -0,0 +1,268 @@
+﻿// © 2024 Daniel Münch. All Rights Reserved
+
+#include "UI/ItemVisualsPreloadSubsystem.h"
+
+#include "InventorySystem.h"
+#include "ItemContainerComponent.h"
+#include "Engine/AssetManager.h"
+#include "Engine/Engine.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+
+#define LOCTEXT_NAMESPACE "InventorySystem"
+
+const FName UItemVisualsPreloadSubsystem::VisualsBundleName = FName(TEXT("Visuals"));
+
+UItemVisualsPreloadSubsystem* UItemVisualsPreloadSubsystem::Get(const UObject* WorldContextObject)
+{
+	if (const UWorld* World = GEngine != nullptr ? GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull) : nullptr; IsValid(World))
+	{
+		return UGameInstance::GetSubsystem<UItemVisualsPreloadSubsystem>(World->GetGameInstance());
+	}
+
+	return nullptr;
+}
+
+void UItemVisualsPreloadSubsystem::Deinitialize()
+{
+	for (TPair<FPrimaryAssetId, FItemVisualsRequest>& VisualsRequest : VisualsRequests)
+	{
+		if (VisualsRequest.Value.Handle.IsValid() && VisualsRequest.Value.bIsLoaded)
+		{
+			VisualsRequest.Value.Handle->ReleaseHandle();
+		}
+		else if (VisualsRequest.Value.Handle.IsValid())
+		{
+			VisualsRequest.Value.Handle->CancelHandle();
+		}
+	}
+
+	VisualsRequests.Empty();
+	RequestedAssetsByRequester.Empty();
+
+	Super::Deinitialize();
+}
+
+void UItemVisualsPreloadSubsystem::RequestItemVisuals(UObject* Requester, const TArray<FPrimaryAssetId>& VisibleAssets, const TArray<FPrimaryAssetId>& AdjacentAssets)
+{
+	if (!IsValid(Requester))
+	{
+		return;
+	}
+
+	TMap<FPrimaryAssetId, TAsyncLoadPriority> NewAssets;
+	for (const FPrimaryAssetId& Asset : AdjacentAssets)
+	{
+		if (Asset.IsValid())
+		{
+			NewAssets.Add(Asset, FStreamableManager::DefaultAsyncLoadPriority);
+		}
+	}
+
+	// Visible assets override the priority of adjacent assets
+	for (const FPrimaryAssetId& Asset : VisibleAssets)
+	{
+		if (Asset.IsValid())
+		{
+			NewAssets.Add(Asset, FStreamableManager::AsyncLoadHighPriority);
+		}
+	}
+
+	TMap<FPrimaryAssetId, TAsyncLoadPriority> OldAssets;
+	RequestedAssetsByRequester.RemoveAndCopyValue(Requester, OldAssets);
+
+	// Add new requests first, so assets shared with the old request are never released in between
+	TArray<FPrimaryAssetId> AssetsToLoad;
+	for (const TPair<FPrimaryAssetId, TAsyncLoadPriority>& NewAsset : NewAssets)
+	{
+		FItemVisualsRequest& Request = VisualsRequests.FindOrAdd(NewAsset.Key);
+		if (!OldAssets.Contains(NewAsset.Key))
+		{
+			Request.RequesterCount++;
+		}
+
+		if (Request.bIsLoaded)
+		{
+			continue;
+		}
+
+		// A running load can not change its priority. Restart it if it became visible
+		if (!Request.Handle.IsValid() || NewAsset.Value > Request.Priority)
+		{
+			Request.Priority = Request.Handle.IsValid() ? FMath::Max(Request.Priority, NewAsset.Value) : NewAsset.Value;
+			AssetsToLoad.Add(NewAsset.Key);
+		}
+	}
+
+	for (const TPair<FPrimaryAssetId, TAsyncLoadPriority>& OldAsset : OldAssets)
+	{
+		if (!NewAssets.Contains(OldAsset.Key))
+		{
+			ReleaseAsset(OldAsset.Key);
+		}
+	}
+
+	if (!NewAssets.IsEmpty())
+	{
+		RequestedAssetsByRequester.Add(Requester, MoveTemp(NewAssets));
+	}
+
+	// Start loading last. Loaded listeners can run right away and request visuals again
+	for (const FPrimaryAssetId& Asset : AssetsToLoad)
+	{
+		StartLoading(Asset);
+	}
+}
+
+void UItemVisualsPreloadSubsystem::PreloadInventorySlots(UObject* Requester, const UItemContainerComponent* ItemContainerComponent, const int FirstSlot, const int LastSlot, const int AdjacentSlots)
+{
+	if (!IsValid(ItemContainerComponent))
+	{
+		ReleaseItemVisuals(Requester);
+		return;
+	}
+
+	const int InventorySize = ItemContainerComponent->GetInventorySizeConfig();
+	const int VisibleFirst = FMath::Max(FirstSlot, 1);
+	const int VisibleLast = FMath::Min(LastSlot, InventorySize);
+	const int AdjacentFirst = FMath::Max(VisibleFirst - FMath::Max(AdjacentSlots, 0), 1);
+	const int AdjacentLast = FMath::Min(VisibleLast + FMath::Max(AdjacentSlots, 0), InventorySize);
+
+	TSet<FPrimaryAssetId> VisibleAssets;
+	TSet<FPrimaryAssetId> AdjacentAssets;
+	for (int Slot = AdjacentFirst; Slot <= AdjacentLast; Slot++)
+	{
+		if (const FInventorySlot InventorySlot = ItemContainerComponent->GetInventorySlot(Slot); InventorySlot.Slot != INDEX_NONE)
+		{
+			if (Slot >= VisibleFirst && Slot <= VisibleLast)
+			{
+				VisibleAssets.Add(InventorySlot.Asset);
+			}
+			else
+			{
+				AdjacentAssets.Add(InventorySlot.Asset);
+			}
+		}
+	}
+
+	RequestItemVisuals(Requester, VisibleAssets.Array(), AdjacentAssets.Array());
+}
+
+void UItemVisualsPreloadSubsystem::ReleaseItemVisuals(UObject* Requester)
+{
+	TMap<FPrimaryAssetId, TAsyncLoadPriority> OldAssets;
+	if (!RequestedAssetsByRequester.RemoveAndCopyValue(Requester, OldAssets))
+	{
+		return;
+	}
+
+	for (const TPair<FPrimaryAssetId, TAsyncLoadPriority>& OldAsset : OldAssets)
+	{
+		ReleaseAsset(OldAsset.Key);
+	}
+}
+
+EItemVisualsLoadState UItemVisualsPreloadSubsystem::GetItemVisualsLoadState(const FPrimaryAssetId& Asset) const
+{
+	if (const FItemVisualsRequest* Request = VisualsRequests.Find(Asset))
+	{
+		return Request->bIsLoaded ? EItemVisualsLoadState::Loaded : EItemVisualsLoadState::Loading;
+	}
+
+	return EItemVisualsLoadState::NotRequested;
+}
+
+void UItemVisualsPreloadSubsystem::StartLoading(const FPrimaryAssetId& Asset)
+{
+	// Released by a listener of an earlier load
+	const FItemVisualsRequest* Request = VisualsRequests.Find(Asset);
+	if (Request == nullptr)
+	{
+		return;
+	}
+
+	UAssetManager* AssetManager = UAssetManager::GetIfInitialized();
+	if (!IsValid(AssetManager))
+	{
+		UE_LOG(InventorySystem, Warning, TEXT("[UItemVisualsPreloadSubsystem|%s][StartLoading]: AssetManager is not initialized"), *GetFName().ToString());
+		return;
+	}
+
+	// Load the item and its bundle with an own handle. LoadPrimaryAsset would replace the bundle state the game set for the item
+	// and keep the item loaded until UnloadPrimaryAsset is called
+	TArray<FSoftObjectPath> AssetPaths;
+	AssetPaths.Add(AssetManager->GetPrimaryAssetPath(Asset));
+	const FAssetBundleEntry BundleEntry = AssetManager->GetAssetBundleEntry(Asset, VisualsBundleName);
+	for (const auto& AssetPath : BundleEntry.AssetPaths)
+	{
+		AssetPaths.Add(FSoftObjectPath(AssetPath));
+	}
+
+	const TSharedPtr<FStreamableHandle> NewHandle = AssetManager->GetStreamableManager().RequestAsyncLoad(AssetPaths, FStreamableDelegate::CreateUObject(this, &UItemVisualsPreloadSubsystem::HandleVisualsLoaded, Asset), Request->Priority);
+
+	// The loaded callback may have run and released the asset
+	FItemVisualsRequest* CurrentRequest = VisualsRequests.Find(Asset);
+	if (CurrentRequest == nullptr)
+	{
+		if (NewHandle.IsValid() && NewHandle->HasLoadCompleted())
+		{
+			NewHandle->ReleaseHandle();
+		}
+		else if (NewHandle.IsValid())
+		{
+			NewHandle->CancelHandle();
+		}
+		return;
+	}
+
+	// Only the handle of this subsystem is replaced. Loads of other callers are not affected
+	if (CurrentRequest->Handle.IsValid())
+	{
+		CurrentRequest->Handle->CancelHandle();
+	}
+
+	CurrentRequest->Handle = NewHandle;
+
+	// Nothing to load, for example if the item has no valid path
+	if (!NewHandle.IsValid())
+	{
+		CurrentRequest->bIsLoaded = true;
+	}
+}
+
+void UItemVisualsPreloadSubsystem::ReleaseAsset(const FPrimaryAssetId& Asset)
+{
+	FItemVisualsRequest* Request = VisualsRequests.Find(Asset);
+	if (Request == nullptr || --Request->RequesterCount > 0)
+	{
+		return;
+	}
+
+	if (Request->Handle.IsValid())
+	{
+		if (Request->bIsLoaded)
+		{
+			Request->Handle->ReleaseHandle();
+		}
+		else
+		{
+			Request->Handle->CancelHandle();
+		}
+	}
+
+	VisualsRequests.Remove(Asset);
+}
+
+void UItemVisualsPreloadSubsystem::HandleVisualsLoaded(const FPrimaryAssetId Asset)
+{
+	FItemVisualsRequest* Request = VisualsRequests.Find(Asset);
+	if (Request == nullptr || Request->bIsLoaded)
+	{
+		return;
+	}
+
+	Request->bIsLoaded = true;
+	ItemVisualsLoadedDelegate.Broadcast(Asset);
+}
+
+#undef LOCTEXT_NAMESPACE
@@ -3,64 +3,117 @@
 #include "UI/UI_EquipmentItem.h"
 
 #include "InventorySystemComponent.h"
-#include "Engine/GameInstance.h"
-#include "GameFramework/PlayerState.h"
+#include "UI/InventorySystemWidgetSubsystem.h"
 
 #define LOCTEXT_NAMESPACE "UUI_EquipmentItem"
 
 UUI_EquipmentItem::UUI_EquipmentItem()
 {
-	if (IsValid(UWidget::GetWorld()))
-	{
-		UWidget::GetWorld()->GetTimerManager().SetTimer(InitEquipmentSlotTimerHandle, this, &UUI_EquipmentItem::InitEquipmentSlot, 0.25f, true, 0.01f);
-	}
 }
 
 void UUI_EquipmentItem::FinishDestroy()
 {
-	if (UInventorySystemComponent* Component = GetUsedInventorySystemComponent(); IsValid(Component))
+	if (UInventorySystemWidgetSubsystem* Subsystem = ResolvedComponentsSubsystem.Get())
 	{
-		Component->ChangedEquipmentSlotsDelegate.RemoveDynamic(this, &UUI_EquipmentItem::CallChangeDelegate);
+		Subsystem->ResolvedPlayerComponentsChangedDelegate.Remove(ResolvedComponentsChangedHandle);
 	}
+	UnsubscribeEquipmentSlot();
 
 	Super::FinishDestroy();
 }
 
 void UUI_EquipmentItem::SetCustomInventorySystemComponent(UInventorySystemComponent* const& InventorySystemComponent)
 {
-	if (UInventorySystemComponent* Component = GetUsedInventorySystemComponent(); IsValid(Component))
-	{
-		Component->ChangedEquipmentSlotsDelegate.RemoveDynamic(this, &UUI_EquipmentItem::CallChangeDelegate);
-	}
+	UnsubscribeEquipmentSlot();
 	CustomInventorySystemComponent = InventorySystemComponent;
+	CachedEquipmentSlotGeneration = INDEX_NONE;
 	InitEquipmentSlot();
 }
 
+void UUI_EquipmentItem::SetEquipmentSlot(const int NewEquipmentSlot)
+{
+	EquipmentSlot = NewEquipmentSlot;
+	CachedEquipmentSlotGeneration = INDEX_NONE;
+	if (SubscribedInventorySystemComponent.IsValid())
+	{
+		InitEquipmentSlot();
+	}
+}
+
+void UUI_EquipmentItem::UnsubscribeEquipmentSlot()
+{
+	if (UInventorySystemComponent* Component = SubscribedInventorySystemComponent.Get())
+	{
+		Component->UnsubscribeEquipmentSlot(SubscribedEquipmentSlot, EquipmentSlotSubscriptionHandle);
+	}
+
+	SubscribedInventorySystemComponent.Reset();
+	SubscribedEquipmentSlot = INDEX_NONE;
+	EquipmentSlotSubscriptionHandle.Reset();
+}
+
 FEquipmentSlot UUI_EquipmentItem::GetEquipmentSlotData()
 {
 	if (const UInventorySystemComponent* Component = GetUsedInventorySystemComponent(); IsValid(Component))
 	{
-		return Component->GetEquipmentSlot(EquipmentSlot);
+		// Skip the copy from the component if nothing changed since the last read
+		const int Generation = Component->GetEquipmentSlotGeneration(EquipmentSlot);
+		if (Generation == INDEX_NONE || Generation != CachedEquipmentSlotGeneration || CachedEquipmentSlotData.Slot != EquipmentSlot)
+		{
+			CachedEquipmentSlotData = Component->GetCachedEquipmentSlot(EquipmentSlot);
+			CachedEquipmentSlotGeneration = Generation;
+		}
+
+		return CachedEquipmentSlotData;
 	}
 
 	return FEquipmentSlot{};
 }
 
+bool UUI_EquipmentItem::IsEquipmentSlotDataOutdated()
+{
+	if (const UInventorySystemComponent* Component = GetUsedInventorySystemComponent(); IsValid(Component))
+	{
+		const int Generation = Component->GetEquipmentSlotGeneration(EquipmentSlot);
+		return Generation == INDEX_NONE || Generation != CachedEquipmentSlotGeneration || CachedEquipmentSlotData.Slot != EquipmentSlot;
+	}
+
+	return true;
+}
+
 void UUI_EquipmentItem::InitEquipmentSlot()
 {
 	if (UInventorySystemComponent* Component = GetUsedInventorySystemComponent(); IsValid(Component))
 	{
-		Component->ChangedEquipmentSlotsDelegate.AddUniqueDynamic(this, &UUI_EquipmentItem::CallChangeDelegate);
-		UWidget::GetWorld()->GetTimerManager().ClearTimer(InitEquipmentSlotTimerHandle);
+		if (SubscribedInventorySystemComponent.Get() != Component || SubscribedEquipmentSlot != EquipmentSlot)
+		{
+			UnsubscribeEquipmentSlot();
+			EquipmentSlotSubscriptionHandle = Component->SubscribeEquipmentSlot(EquipmentSlot, FSlotSubscriptionDelegate::FDelegate::CreateUObject(this, &UUI_EquipmentItem::CallChangeDelegate));
+			SubscribedInventorySystemComponent = Component;
+			SubscribedEquipmentSlot = EquipmentSlot;
+		}
 		EquipmentSlotChangedDelegate.Broadcast(false);
+		return;
+	}
+
+	// No component yet. HandleResolvedComponentsChanged initializes again once the subsystem resolved it
+}
+
+void UUI_EquipmentItem::HandleResolvedComponentsChanged()
+{
+	if (!IsValid(CustomInventorySystemComponent))
+	{
+		// Generations are per component. A new component can report the same generation for different data
+		CachedEquipmentSlotGeneration = INDEX_NONE;
+		InitEquipmentSlot();
 	}
 }
 
-void UUI_EquipmentItem::CallChangeDelegate(const TArray<int>& EquipmentSlots)
+void UUI_EquipmentItem::CallChangeDelegate(const int ChangedEquipmentSlot)
 {
-	if (EquipmentSlots.Contains(EquipmentSlot))
+	if (ChangedEquipmentSlot == EquipmentSlot)
 	{
-		if (UInventorySystemComponent* Component = GetUsedInventorySystemComponent(); IsValid(Component) && Component->GetEquipmentSlot(EquipmentSlot).Slot == INDEX_NONE)
+		if (UInventorySystemComponent* Component = GetUsedInventorySystemComponent(); IsValid(Component) && Component->GetCachedEquipmentSlot(EquipmentSlot).Slot == INDEX_NONE)
 		{
 			EquipmentSlotChangedDelegate.Broadcast(true);
 			return;
@@ -76,20 +129,10 @@ UInventorySystemComponent* UUI_EquipmentItem::GetUsedInventorySystemComponent()
 		return CustomInventorySystemComponent;
 	}
 
-	if (!IsValid(PlayerStateInventorySystemComponent) && GetGameInstance() != nullptr && GetGameInstance()->IsValidLowLevel()) {
-		if (const APlayerController* PlayerController = GetOwningPlayer(); IsValid(PlayerController)) {
-			if (const APlayerState* PlayerState = GetOwningPlayer()->GetPlayerState<APlayerState>(); IsValid(PlayerState))
-			{
-				if (UInventorySystemComponent* InventorySystemComponent = Cast<UInventorySystemComponent>(PlayerState->GetComponentByClass(UInventorySystemComponent::StaticClass())); IsValid(InventorySystemComponent))
-				{
-					return InventorySystemComponent;
-				}
-			}
-		}
-	}
-	else
+	// Resolved once per player and shared by all slot widgets
+	if (UInventorySystemWidgetSubsystem* Subsystem = UInventorySystemWidgetSubsystem::Get(GetOwningPlayer()); IsValid(Subsystem))
 	{
-		return PlayerStateInventorySystemComponent;
+		return Subsystem->GetInventorySystemComponent(GetOwningPlayer());
 	}
 
 	return nullptr;
@@ -99,6 +142,21 @@ TSharedRef<SWidget> UUI_EquipmentItem::RebuildWidget()
 {
 	auto OverlayWidget = Super::RebuildWidget();
 
+	// The owning player is known once the widget is built
+	if (!IsDesignTime())
+	{
+		if (UInventorySystemWidgetSubsystem* Subsystem = UInventorySystemWidgetSubsystem::Get(GetOwningPlayer()); IsValid(Subsystem) && !ResolvedComponentsChangedHandle.IsValid())
+		{
+			ResolvedComponentsChangedHandle = Subsystem->ResolvedPlayerComponentsChangedDelegate.AddUObject(this, &UUI_EquipmentItem::HandleResolvedComponentsChanged);
+			ResolvedComponentsSubsystem = Subsystem;
+		}
+
+		if (!SubscribedInventorySystemComponent.IsValid())
+		{
+			InitEquipmentSlot();
+		}
+	}
+
 	return OverlayWidget;
 }
 
@@ -3,39 +3,53 @@
 #include "UI/UI_InventoryItem.h"
 
 #include "InventorySystemComponent.h"
-#include "Engine/GameInstance.h"
-#include "GameFramework/PlayerState.h"
+#include "UI/InventorySystemWidgetSubsystem.h"
 
 #define LOCTEXT_NAMESPACE "UUI_InventoryItem"
 
 UUI_InventoryItem::UUI_InventoryItem()
 {
-	if (IsValid(UWidget::GetWorld()))
-	{
-		UWidget::GetWorld()->GetTimerManager().SetTimer(InitInventorySlotTimerHandle, this, &UUI_InventoryItem::InitInventorySlot, 0.25f, true, 0.01f);
-	}
 }
 
 void UUI_InventoryItem::FinishDestroy()
 {
-	if (UItemContainerComponent* Component = GetUsedItemContainerComponent(); IsValid(Component))
+	if (UInventorySystemWidgetSubsystem* Subsystem = ResolvedComponentsSubsystem.Get())
 	{
-		Component->ChangedInventorySlotsDelegate.RemoveDynamic(this, &UUI_InventoryItem::CallChangeDelegate);
+		Subsystem->ResolvedPlayerComponentsChangedDelegate.Remove(ResolvedComponentsChangedHandle);
 	}
+	UnsubscribeInventorySlot();
 
 	Super::FinishDestroy();
 }
 
 void UUI_InventoryItem::SetCustomItemContainerComponent(UItemContainerComponent* const& ItemContainerComponent)
 {
-	if (UItemContainerComponent* Component = GetUsedItemContainerComponent(); IsValid(Component))
-	{
-		Component->ChangedInventorySlotsDelegate.RemoveDynamic(this, &UUI_InventoryItem::CallChangeDelegate);
-	}
+	UnsubscribeInventorySlot();
 	CustomItemContainerComponent = ItemContainerComponent;
 	InitInventorySlot();
 }
 
+void UUI_InventoryItem::SetInventorySlot(const int NewInventorySlot)
+{
+	InventorySlot = NewInventorySlot;
+	if (SubscribedItemContainerComponent.IsValid())
+	{
+		InitInventorySlot();
+	}
+}
+
+void UUI_InventoryItem::UnsubscribeInventorySlot()
+{
+	if (UItemContainerComponent* Component = SubscribedItemContainerComponent.Get())
+	{
+		Component->UnsubscribeInventorySlot(SubscribedInventorySlot, InventorySlotSubscriptionHandle);
+	}
+
+	SubscribedItemContainerComponent.Reset();
+	SubscribedInventorySlot = INDEX_NONE;
+	InventorySlotSubscriptionHandle.Reset();
+}
+
 UItemContainerComponent* UUI_InventoryItem::GetUsedItemContainerComponent()
 {
 	if (IsValid(CustomItemContainerComponent))
@@ -43,20 +57,10 @@ UItemContainerComponent* UUI_InventoryItem::GetUsedItemContainerComponent()
 		return CustomItemContainerComponent;
 	}
 
-	if (!IsValid(PlayerStateInventorySystemComponent) && GetGameInstance() != nullptr && GetGameInstance()->IsValidLowLevel()) {
-		if (const APlayerController* PlayerController = GetOwningPlayer(); IsValid(PlayerController)) {
-			if (const APlayerState* PlayerState = GetOwningPlayer()->GetPlayerState<APlayerState>(); IsValid(PlayerState))
-			{
-				if (UItemContainerComponent* InventorySystemComponent = Cast<UItemContainerComponent>(PlayerState->GetComponentByClass(UItemContainerComponent::StaticClass())); IsValid(InventorySystemComponent))
-				{
-					return InventorySystemComponent;
-				}
-			}
-		}
-	}
-	else
+	// Resolved once per player and shared by all slot widgets
+	if (UInventorySystemWidgetSubsystem* Subsystem = UInventorySystemWidgetSubsystem::Get(GetOwningPlayer()); IsValid(Subsystem))
 	{
-		return PlayerStateInventorySystemComponent;
+		return Subsystem->GetItemContainerComponent(GetOwningPlayer());
 	}
 
 	return nullptr;
@@ -76,15 +80,31 @@ void UUI_InventoryItem::InitInventorySlot()
 {
 	if (UItemContainerComponent* Component = GetUsedItemContainerComponent(); IsValid(Component))
 	{
-		Component->ChangedInventorySlotsDelegate.AddUniqueDynamic(this, &UUI_InventoryItem::CallChangeDelegate);
-		UWidget::GetWorld()->GetTimerManager().ClearTimer(InitInventorySlotTimerHandle);
+		if (SubscribedItemContainerComponent.Get() != Component || SubscribedInventorySlot != InventorySlot)
+		{
+			UnsubscribeInventorySlot();
+			InventorySlotSubscriptionHandle = Component->SubscribeInventorySlot(InventorySlot, FSlotSubscriptionDelegate::FDelegate::CreateUObject(this, &UUI_InventoryItem::CallChangeDelegate));
+			SubscribedItemContainerComponent = Component;
+			SubscribedInventorySlot = InventorySlot;
+		}
 		InventorySlotChangedDelegate.Broadcast(false);
+		return;
+	}
+
+	// No component yet. HandleResolvedComponentsChanged initializes again once the subsystem resolved it
+}
+
+void UUI_InventoryItem::HandleResolvedComponentsChanged()
+{
+	if (!IsValid(CustomItemContainerComponent))
+	{
+		InitInventorySlot();
 	}
 }
 
-void UUI_InventoryItem::CallChangeDelegate(const TArray<int>& InventorySlots)
+void UUI_InventoryItem::CallChangeDelegate(const int ChangedInventorySlot)
 {
-	if (InventorySlots.Contains(InventorySlot))
+	if (ChangedInventorySlot == InventorySlot)
 	{
 		if (UItemContainerComponent* Component = GetUsedItemContainerComponent(); IsValid(Component) && Component->GetInventorySlot(InventorySlot).Slot == INDEX_NONE)
 		{
@@ -98,6 +118,22 @@ void UUI_InventoryItem::CallChangeDelegate(const TArray<int>& InventorySlots)
 TSharedRef<SWidget> UUI_InventoryItem::RebuildWidget()
 {
 	auto OverlayWidget = Super::RebuildWidget();
+
+	// The owning player is known once the widget is built
+	if (!IsDesignTime())
+	{
+		if (UInventorySystemWidgetSubsystem* Subsystem = UInventorySystemWidgetSubsystem::Get(GetOwningPlayer()); IsValid(Subsystem) && !ResolvedComponentsChangedHandle.IsValid())
+		{
+			ResolvedComponentsChangedHandle = Subsystem->ResolvedPlayerComponentsChangedDelegate.AddUObject(this, &UUI_InventoryItem::HandleResolvedComponentsChanged);
+			ResolvedComponentsSubsystem = Subsystem;
+		}
+
+		if (!SubscribedItemContainerComponent.IsValid())
+		{
+			InitInventorySlot();
+		}
+	}
+
 	return OverlayWidget;
 }
 
@@ -0,0 +1,52 @@
+﻿// © 2024 Daniel Münch. All Rights Reserved
+
+#include "UI/UI_InventorySlotEntry.h"
+
+#include "UI/InventorySlotListItem.h"
+
+#define LOCTEXT_NAMESPACE "UUI_InventorySlotEntry"
+
+void UUI_InventorySlotEntry::NativeOnListItemObjectSet(UObject* ListItemObject)
+{
+	IUserObjectListEntry::NativeOnListItemObjectSet(ListItemObject);
+
+	InventorySlotListItem = Cast<UInventorySlotListItem>(ListItemObject);
+	CallChangeDelegate();
+}
+
+void UUI_InventorySlotEntry::CallChangeDelegate()
+{
+	InventorySlotChangedDelegate.Broadcast(GetInventorySlotData().Slot == INDEX_NONE);
+}
+
+int UUI_InventorySlotEntry::GetInventorySlot() const
+{
+	if (IsValid(InventorySlotListItem))
+	{
+		return InventorySlotListItem->InventorySlot;
+	}
+
+	return INDEX_NONE;
+}
+
+FInventorySlot UUI_InventorySlotEntry::GetInventorySlotData() const
+{
+	if (IsValid(InventorySlotListItem))
+	{
+		return InventorySlotListItem->GetInventorySlotData();
+	}
+
+	return FInventorySlot{};
+}
+
+EItemVisualsLoadState UUI_InventorySlotEntry::GetVisualsLoadState() const
+{
+	if (const UItemVisualsPreloadSubsystem* PreloadSubsystem = UItemVisualsPreloadSubsystem::Get(this); IsValid(PreloadSubsystem))
+	{
+		return PreloadSubsystem->GetItemVisualsLoadState(GetInventorySlotData().Asset);
+	}
+
+	return EItemVisualsLoadState::NotRequested;
+}
+
+#undef LOCTEXT_NAMESPACE
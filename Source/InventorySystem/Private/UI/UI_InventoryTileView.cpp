@@ -0,0 +1,275 @@
+﻿// © 2024 Daniel Münch. All Rights Reserved
+
+#include "UI/UI_InventoryTileView.h"
+
+#include "ItemContainerComponent.h"
+#include "UI/InventorySlotListItem.h"
+#include "TimerManager.h"
+#include "UI/InventorySystemWidgetSubsystem.h"
+#include "UI/ItemVisualsPreloadSubsystem.h"
+#include "UI/UI_InventorySlotEntry.h"
+
+#define LOCTEXT_NAMESPACE "UUI_InventoryTileView"
+
+void UUI_InventoryTileView::FinishDestroy()
+{
+	if (UInventorySystemWidgetSubsystem* Subsystem = ResolvedComponentsSubsystem.Get())
+	{
+		Subsystem->ResolvedPlayerComponentsChangedDelegate.Remove(ResolvedComponentsChangedHandle);
+	}
+	if (UItemContainerComponent* Component = BoundItemContainerComponent.Get())
+	{
+		Component->ChangedInventorySlotsDelegate.RemoveDynamic(this, &UUI_InventoryTileView::HandleChangedInventorySlots);
+	}
+
+	if (UItemVisualsPreloadSubsystem* PreloadSubsystem = UItemVisualsPreloadSubsystem::Get(this); IsValid(PreloadSubsystem))
+	{
+		PreloadSubsystem->ReleaseItemVisuals(this);
+		PreloadSubsystem->ItemVisualsLoadedDelegate.RemoveDynamic(this, &UUI_InventoryTileView::HandleItemVisualsLoaded);
+	}
+
+	Super::FinishDestroy();
+}
+
+void UUI_InventoryTileView::SetCustomItemContainerComponent(UItemContainerComponent* const& ItemContainerComponent)
+{
+	CustomItemContainerComponent = ItemContainerComponent;
+	InitItemContainerComponent();
+}
+
+UItemContainerComponent* UUI_InventoryTileView::GetUsedItemContainerComponent()
+{
+	if (IsValid(CustomItemContainerComponent))
+	{
+		return CustomItemContainerComponent;
+	}
+
+	// Resolved once per player and shared by all slot widgets
+	if (UInventorySystemWidgetSubsystem* Subsystem = UInventorySystemWidgetSubsystem::Get(GetOwningPlayer()); IsValid(Subsystem))
+	{
+		return Subsystem->GetItemContainerComponent(GetOwningPlayer());
+	}
+
+	return nullptr;
+}
+
+UInventorySlotListItem* UUI_InventoryTileView::GetInventorySlotListItem(const int Slot) const
+{
+	if (InventorySlotListItems.IsValidIndex(Slot - 1))
+	{
+		return InventorySlotListItems[Slot - 1];
+	}
+
+	return nullptr;
+}
+
+void UUI_InventoryTileView::InitItemContainerComponent()
+{
+	if (UItemContainerComponent* Component = GetUsedItemContainerComponent(); IsValid(Component))
+	{
+		BindItemContainerComponent(Component);
+		return;
+	}
+
+	UnbindItemContainerComponent();
+
+	// No component yet. HandleResolvedComponentsChanged binds once the subsystem resolved it
+}
+
+void UUI_InventoryTileView::BindItemContainerComponent(UItemContainerComponent* Component)
+{
+	if (BoundItemContainerComponent.Get() == Component)
+	{
+		return;
+	}
+
+	UnbindItemContainerComponent();
+
+	BoundItemContainerComponent = Component;
+	Component->ChangedInventorySlotsDelegate.AddDynamic(this, &UUI_InventoryTileView::HandleChangedInventorySlots);
+	RebuildInventorySlotListItems();
+}
+
+void UUI_InventoryTileView::UnbindItemContainerComponent()
+{
+	if (UItemContainerComponent* Component = BoundItemContainerComponent.Get())
+	{
+		Component->ChangedInventorySlotsDelegate.RemoveDynamic(this, &UUI_InventoryTileView::HandleChangedInventorySlots);
+	}
+
+	BoundItemContainerComponent.Reset();
+	InventorySlotListItems.Empty();
+	ClearListItems();
+
+	if (UItemVisualsPreloadSubsystem* PreloadSubsystem = UItemVisualsPreloadSubsystem::Get(this); IsValid(PreloadSubsystem))
+	{
+		PreloadSubsystem->ReleaseItemVisuals(this);
+	}
+}
+
+void UUI_InventoryTileView::RebuildInventorySlotListItems()
+{
+	UItemContainerComponent* Component = BoundItemContainerComponent.Get();
+	if (!IsValid(Component))
+	{
+		return;
+	}
+
+	// List items are reused, so entries of unchanged slots keep their widgets
+	const int InventorySize = FMath::Max(Component->GetInventorySizeConfig(), 0);
+	const int PreviousSize = InventorySlotListItems.Num();
+	InventorySlotListItems.SetNum(InventorySize);
+	for (int Index = 0; Index < InventorySize; ++Index)
+	{
+		if (Index >= PreviousSize || !IsValid(InventorySlotListItems[Index]))
+		{
+			InventorySlotListItems[Index] = NewObject<UInventorySlotListItem>(this);
+		}
+		InventorySlotListItems[Index]->SetInventorySlot(Component, Index + 1);
+	}
+
+	SetListItems(InventorySlotListItems);
+
+	for (UUserWidget* EntryWidget : GetDisplayedEntryWidgets())
+	{
+		if (UUI_InventorySlotEntry* Entry = Cast<UUI_InventorySlotEntry>(EntryWidget); IsValid(Entry))
+		{
+			Entry->CallChangeDelegate();
+		}
+	}
+
+	SchedulePreloadItemVisuals();
+}
+
+void UUI_InventoryTileView::HandleChangedInventorySlots(const TArray<int>& Slots)
+{
+	const UItemContainerComponent* Component = BoundItemContainerComponent.Get();
+	if (!IsValid(Component))
+	{
+		return;
+	}
+
+	if (InventorySlotListItems.Num() != Component->GetInventorySizeConfig())
+	{
+		RebuildInventorySlotListItems();
+		return;
+	}
+
+	// Entries only exist for visible rows. All other slots are read when they scroll into view
+	bool bHasVisibleChange = false;
+	for (const int Slot : Slots)
+	{
+		if (!InventorySlotListItems.IsValidIndex(Slot - 1))
+		{
+			continue;
+		}
+
+		if (UUI_InventorySlotEntry* Entry = Cast<UUI_InventorySlotEntry>(GetEntryWidgetFromItem(InventorySlotListItems[Slot - 1])); IsValid(Entry))
+		{
+			Entry->CallChangeDelegate();
+			bHasVisibleChange = true;
+		}
+	}
+
+	// Replicated slots near the visible page may need other visuals
+	if (bHasVisibleChange || PreloadAdjacentPages > 0)
+	{
+		SchedulePreloadItemVisuals();
+	}
+}
+
+void UUI_InventoryTileView::SchedulePreloadItemVisuals()
+{
+	if (bIsPreloadPending || PreloadAdjacentPages == INDEX_NONE || IsDesignTime() || !IsValid(GetWorld()))
+	{
+		return;
+	}
+
+	bIsPreloadPending = true;
+	GetWorld()->GetTimerManager().SetTimerForNextTick(this, &UUI_InventoryTileView::PreloadItemVisuals);
+}
+
+void UUI_InventoryTileView::PreloadItemVisuals()
+{
+	bIsPreloadPending = false;
+
+	UItemVisualsPreloadSubsystem* PreloadSubsystem = UItemVisualsPreloadSubsystem::Get(this);
+	const UItemContainerComponent* Component = BoundItemContainerComponent.Get();
+	if (!IsValid(PreloadSubsystem) || !IsValid(Component))
+	{
+		return;
+	}
+
+	int FirstSlot = MAX_int32;
+	int LastSlot = INDEX_NONE;
+	for (const UUserWidget* EntryWidget : GetDisplayedEntryWidgets())
+	{
+		if (const UUI_InventorySlotEntry* Entry = Cast<UUI_InventorySlotEntry>(EntryWidget); IsValid(Entry) && Entry->GetInventorySlot() != INDEX_NONE)
+		{
+			FirstSlot = FMath::Min(FirstSlot, Entry->GetInventorySlot());
+			LastSlot = FMath::Max(LastSlot, Entry->GetInventorySlot());
+		}
+	}
+
+	if (LastSlot == INDEX_NONE)
+	{
+		return;
+	}
+
+	const int PageSize = LastSlot - FirstSlot + 1;
+	PreloadSubsystem->PreloadInventorySlots(this, Component, FirstSlot, LastSlot, PageSize * FMath::Max(PreloadAdjacentPages, 0));
+}
+
+void UUI_InventoryTileView::HandleItemVisualsLoaded(const FPrimaryAssetId& Asset)
+{
+	for (UUserWidget* EntryWidget : GetDisplayedEntryWidgets())
+	{
+		if (UUI_InventorySlotEntry* Entry = Cast<UUI_InventorySlotEntry>(EntryWidget); IsValid(Entry) && Entry->GetInventorySlotData().Asset == Asset)
+		{
+			Entry->CallChangeDelegate();
+		}
+	}
+}
+
+void UUI_InventoryTileView::HandleResolvedComponentsChanged()
+{
+	if (!IsValid(CustomItemContainerComponent))
+	{
+		InitItemContainerComponent();
+	}
+}
+
+TSharedRef<SWidget> UUI_InventoryTileView::RebuildWidget()
+{
+	auto TileViewWidget = Super::RebuildWidget();
+
+	if (!IsDesignTime())
+	{
+		if (UInventorySystemWidgetSubsystem* Subsystem = UInventorySystemWidgetSubsystem::Get(GetOwningPlayer()); IsValid(Subsystem) && !ResolvedComponentsChangedHandle.IsValid())
+		{
+			ResolvedComponentsChangedHandle = Subsystem->ResolvedPlayerComponentsChangedDelegate.AddUObject(this, &UUI_InventoryTileView::HandleResolvedComponentsChanged);
+			ResolvedComponentsSubsystem = Subsystem;
+		}
+
+		// Entries are generated and recycled while scrolling. Preload the visuals of the new page and its neighbours
+		if (!bIsPreloadBound)
+		{
+			bIsPreloadBound = true;
+			OnEntryWidgetGenerated().AddWeakLambda(this, [this](UUserWidget&) { SchedulePreloadItemVisuals(); });
+			OnListViewScrolled().AddWeakLambda(this, [this](float, float) { SchedulePreloadItemVisuals(); });
+			if (UItemVisualsPreloadSubsystem* PreloadSubsystem = UItemVisualsPreloadSubsystem::Get(this); IsValid(PreloadSubsystem))
+			{
+				PreloadSubsystem->ItemVisualsLoadedDelegate.AddUniqueDynamic(this, &UUI_InventoryTileView::HandleItemVisualsLoaded);
+			}
+		}
+
+		if (!BoundItemContainerComponent.IsValid())
+		{
+			InitItemContainerComponent();
+		}
+	}
+
+	return TileViewWidget;
+}
+
+#undef LOCTEXT_NAMESPACE
@@ -0,0 +1,72 @@
+﻿// © 2024 Daniel Münch. All Rights Reserved
+
+#pragma once
+
+#include "ItemProperties.h"
+#include "EquipmentLoadout.generated.h"
+
+#define LOCTEXT_NAMESPACE "InventorySystem"
+
+/**
+ * @struct FEquipmentLoadoutEntry
+ * @brief A single item of an equipment loadout and the equipment slot it belongs to.
+ */
+USTRUCT(BlueprintType, Category = "Inventory System")
+struct INVENTORYSYSTEM_API FEquipmentLoadoutEntry
+{
+	GENERATED_BODY()
+
+	FEquipmentLoadoutEntry() {};
+
+	FEquipmentLoadoutEntry(const int NewEquipmentSlot, const FPrimaryAssetId& NewAsset, const FItemProperties& NewItemProperties)
+	{
+		EquipmentSlot = NewEquipmentSlot;
+		Asset = NewAsset;
+		ItemProperties = NewItemProperties;
+	};
+
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "Inventory System")
+	int EquipmentSlot = INDEX_NONE;
+
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "Inventory System", meta = (AllowedClasses = "/Script/InventorySystem.ItemEquipmentDataAsset", ExactClass = false))
+	FPrimaryAssetId Asset;
+
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "Inventory System", DisplayName = "Dynamic Item Properties")
+	FItemProperties ItemProperties;
+};
+
+/**
+ * @struct FEquipmentLoadout
+ * @brief A named preset of equipped items, for example PvE and PvP gear.
+ *
+ * General Usage:
+ * - Save the current equipment with UInventorySystemComponent::SaveEquipmentLoadout.
+ * - Switch to it with UInventorySystemComponent::ApplyEquipmentLoadout. All moves between inventory and equipment are applied at once.
+ *
+ * Example Use Case:
+ * @code
+ * InventorySystemComponent->SaveEquipmentLoadout(TEXT("PvP"));
+ * ...
+ * InventorySystemComponent->ApplyEquipmentLoadout(TEXT("PvP"));
+ * @endcode
+ */
+USTRUCT(BlueprintType, Category = "Inventory System")
+struct INVENTORYSYSTEM_API FEquipmentLoadout
+{
+	GENERATED_BODY()
+
+	/**
+	 * Unique name of the loadout.
+	 */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "Inventory System")
+	FName Name;
+
+	/**
+	 * Items of the loadout. Equipment slots without an entry are not changed when the loadout is applied. Each equipment slot
+	 * may only have one entry.
+	 */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "Inventory System")
+	TArray<FEquipmentLoadoutEntry> Entries;
+};
+
+#undef LOCTEXT_NAMESPACE
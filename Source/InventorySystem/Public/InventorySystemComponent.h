@@ -2,9 +2,11 @@
 
 #pragma once
 
+#include "EquipmentLoadout.h"
 #include "EquipmentSlots.h"
 #include "ItemContainerComponent.h"
 #include "ItemDrop.h"
+#include "ItemDropQuery.h"
 #include "ItemEquipmentDataAsset.h"
 #include "InventorySystemComponent.generated.h"
 
@@ -18,6 +20,10 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FPickUpItemSuccessDelegate, AItemDr
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FPickUpItemFailureDelegate, AItemDrop*, ItemDrop);
 
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FPickUpItemDropsSuccessDelegate, const TArray<AItemDrop*>&, ItemDrops, const TArray<int>&, Slots);
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FPickUpItemDropsFailureDelegate, float, Radius);
+
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FAddItemToEquipmentSlotSuccessDelegate, int, EquipmentSlot, const TArray<int>&, Slots, int, Overflow);
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_FourParams(FAddItemToEquipmentSlotFailureDelegate, FPrimaryAssetId, InventoryAsset, int, EquipmentSlot, FItemProperties, DynamicStats, int, Amount);
@@ -36,6 +42,12 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FChangedEquipmentSlotsDelegate, cons
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FSetMaxEquipmentStackSizeSuccessDelegate, bool, bSuccess);
 
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FEquipmentLoadoutSuccessDelegate, bool, bSuccess, FName, LoadoutName);
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_FourParams(FApplyEquipmentLoadoutSuccessDelegate, bool, bSuccess, FName, LoadoutName, const TArray<int>&, EquipmentSlots, const TArray<int>&, Slots);
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FChangedEquipmentStatTotalsDelegate, const TArray<int>&, Slots, const TMap<FName, double>&, Deltas);
+
 /**
  * @class UInventorySystemComponent
  * @brief Manages inventory for a player or NPC, handling item addition, removal, and equipment management.
@@ -216,6 +228,205 @@ protected:
 	UFUNCTION()
 	void OnRep_EquipmentDynamicStats(TArray<FItemProperties> OldEquipmentDynamicStats);
 
+	/**
+	 * Saved equipment presets. Use SaveEquipmentLoadout and ApplyEquipmentLoadout to create and switch loadouts. Only replicated to the owner.
+	 */
+	UPROPERTY(Replicated, BlueprintReadOnly, EditAnywhere, Category = "Inventory System|Loadouts")
+	TArray<FEquipmentLoadout> EquipmentLoadouts;
+
+	/**
+	 * Internal use only. Positions of one equipment slot in the sparse equipment arrays and its cached FEquipmentSlot.
+	 */
+	struct FEquipmentSlotRecord
+	{
+		int TypeIndex = INDEX_NONE;
+		int ItemIndex = INDEX_NONE;
+		int DynamicStatsIndex = INDEX_NONE;
+
+		// Bumped with every change broadcast of this slot
+		int Generation = 0;
+
+		// Generation CachedSlot was built for
+		int CachedGeneration = INDEX_NONE;
+		FEquipmentSlot CachedSlot;
+	};
+
+	/**
+	 * Number of slot numbers covered by EquipmentSlotRecords. Records of higher or negative slot numbers are kept in SparseEquipmentSlotRecords.
+	 */
+	static constexpr int MaxDenseEquipmentSlotRecords = 256;
+
+	/**
+	 * Internal use only. Equipment slot records indexed directly by slot number, sized to the highest slot in EquipmentTypeIndices but at most
+	 * MaxDenseEquipmentSlotRecords. This is a lookup cache over the parallel equipment arrays, not a separate storage. Every cached position is
+	 * verified on read and repaired with an O(n) search after writes that insert, remove or shift entries of the arrays, so the records never
+	 * need to be invalidated. Only resized when equipment types change.
+	 */
+	mutable TArray<FEquipmentSlotRecord> EquipmentSlotRecords;
+
+	/**
+	 * Internal use only. Records of the slots in EquipmentTypeIndices outside of the EquipmentSlotRecords range.
+	 */
+	mutable TMap<int, FEquipmentSlotRecord> SparseEquipmentSlotRecords;
+
+	/**
+	 * Internal use only. Get the cached EquipmentSlot of a slot without copying it. The slot is only rebuilt if it changed since the last call.
+	 * The pointer is invalidated by the next call that resizes the record table. Do not keep it.
+	 *
+	 * @param Slot The target slot index
+	 *
+	 * @return The cached EquipmentSlot or nullptr if the slot has no record.
+	 */
+	const FEquipmentSlot* FindCachedEquipmentSlot(const int Slot) const;
+
+	/**
+	 * Internal use only. Resize the record table to cover all equipment slot numbers. Slots outside of the dense range get a sparse record.
+	 */
+	void ResizeEquipmentSlotRecords();
+
+	/**
+	 * Internal use only. Bump the generation of the given slots and broadcast ChangedEquipmentSlotsDelegate.
+	 * Use this instead of broadcasting the delegate directly.
+	 *
+	 * @param Slots The changed equipment slots.
+	 */
+	void BroadcastChangedEquipmentSlots(const TArray<int>& Slots);
+
+	/**
+	 * Internal use only. Subscribers per equipment slot. See SubscribeEquipmentSlot.
+	 */
+	TMap<int, FSlotSubscriptionDelegate> EquipmentSlotSubscriptions;
+
+	/**
+	 * Internal with return. Dont use for implementation!!! Build an EquipmentSlot from the equipment arrays without the cache.
+	 *
+	 * @param Slot The target slot index
+	 *
+	 * @return The EquipmentSlot.
+	 */
+	FEquipmentSlot BuildEquipmentSlot(const int Slot) const;
+
+	/**
+	 * Internal use only. Get the position of a slot in an index array through its cached position.
+	 *
+	 * @param Indices The index array, for example EquipmentIndices.
+	 * @param CachedIndex The cached position of the slot. Updated if it was stale.
+	 * @param Slot The equipment slot.
+	 *
+	 * @return The position or INDEX_NONE.
+	 */
+	static int FindCachedEquipmentIndex(const TArray<int>& Indices, int& CachedIndex, const int Slot);
+
+	/**
+	 * Internal use only. Get the record of an equipment slot or nullptr if the slot has no record.
+	 *
+	 * @param Slot The equipment slot.
+	 */
+	FEquipmentSlotRecord* GetEquipmentSlotRecord(const int Slot) const;
+
+	/**
+	 * Internal use only. Direct replacement for EquipmentTypeIndices.Find.
+	 *
+	 * @param Slot The equipment slot.
+	 */
+	int FindEquipmentTypeIndex(const int Slot) const;
+
+	/**
+	 * Internal use only. Direct replacement for EquipmentIndices.Find.
+	 *
+	 * @param Slot The equipment slot.
+	 */
+	int FindEquipmentIndex(const int Slot) const;
+
+	/**
+	 * Internal use only. Direct replacement for EquipmentDynamicStatsIndices.Find.
+	 *
+	 * @param Slot The equipment slot.
+	 */
+	int FindEquipmentDynamicStatsIndex(const int Slot) const;
+
+	/**
+	 * Internal use only. Equipment types parsed from the asset registry per asset.
+	 */
+	mutable TMap<FPrimaryAssetId, TArray<FPrimaryAssetId>> AssetEquipmentTypesCache;
+
+	/**
+	 * Internal use only. Equipment slots by equipment type in EquipmentTypes order. Rebuilt when an equipment type changes.
+	 */
+	TMap<FPrimaryAssetId, TArray<int>> EquipmentSlotsByEquipmentType;
+
+	/**
+	 * Internal use only. Inventory slots holding an item that can be equipped to an equipment slot.
+	 */
+	TMap<int, TArray<int>> CompatibleInventorySlotsByEquipmentSlot;
+
+	/**
+	 * Internal use only. Equipment slots an inventory slot was indexed for, used to remove stale entries.
+	 */
+	TMap<int, TArray<int>> CompatibleEquipmentSlotsByInventorySlot;
+
+	/**
+	 * Internal use only. Rebuild the equipment type and compatibility indexes.
+	 */
+	void RebuildEquipmentCompatibilityIndex();
+
+	/**
+	 * Internal use only. Update the compatibility index for changed inventory slots.
+	 *
+	 * @param Slots The changed inventory slots.
+	 */
+	UFUNCTION()
+	virtual void UpdateEquipmentCompatibilityIndex(const TArray<int>& Slots);
+
+	/**
+	 * Internal use only. Update the compatibility index for a single inventory slot.
+	 *
+	 * @param Slot The inventory slot.
+	 */
+	void UpdateEquipmentCompatibilityIndexSlot(const int Slot);
+
+	/**
+	 * Internal use only. Base stats parsed from the asset registry per asset.
+	 */
+	mutable TMap<FPrimaryAssetId, FItemProperties> AssetBaseStatsCache;
+
+	/**
+	 * Internal use only. Numeric stats (base stats plus dynamic stats) each equipment slot contributes to the totals.
+	 */
+	TMap<int, TMap<FName, double>> EquipmentStatsBySlot;
+
+	/**
+	 * Internal use only. Sum of every numeric stat over all equipped items.
+	 */
+	TMap<FName, double> EquipmentStatTotals;
+
+	/**
+	 * Internal use only. Highest value of every numeric stat over all equipped items.
+	 */
+	TMap<FName, double> EquipmentStatMaxes;
+
+	/**
+	 * Internal use only. Calculate the numeric stats of an equipment slot.
+	 *
+	 * @param Slot The equipment slot.
+	 *
+	 * @return The summed base and dynamic stats by property name. Empty if the slot has no item.
+	 */
+	TMap<FName, double> CalculateEquipmentSlotStats(const int Slot) const;
+
+	/**
+	 * Internal use only. Rebuild the aggregated equipment stats of all equipment slots.
+	 */
+	void RebuildEquipmentStatTotals();
+
+	/**
+	 * Internal use only. Update the aggregated equipment stats for changed equipment slots and broadcast the deltas.
+	 *
+	 * @param Slots The changed equipment slots.
+	 */
+	UFUNCTION()
+	virtual void UpdateEquipmentStatTotals(const TArray<int>& Slots);
+
 public:
 #if WITH_EDITOR
 	/**
@@ -252,6 +463,18 @@ public:
 	UPROPERTY(BlueprintAssignable, BlueprintCallable)
 	FPickUpItemFailureDelegate PickUpItemFailureDelegate;
 
+	/**
+	 * Delegate to add functionality after all item drops in a radius were picked up.
+	 */
+	UPROPERTY(BlueprintAssignable, BlueprintCallable)
+	FPickUpItemDropsSuccessDelegate PickUpItemDropsSuccessDelegate;
+
+	/**
+	 * Delegate to add functionality after no item drop in a radius could be picked up.
+	 */
+	UPROPERTY(BlueprintAssignable, BlueprintCallable)
+	FPickUpItemDropsFailureDelegate PickUpItemDropsFailureDelegate;
+
 	/**
 	 * Delegate to add functionality after item was equipped.
 	 */
@@ -300,11 +523,53 @@ public:
 	UPROPERTY(BlueprintAssignable, BlueprintCallable)
 	FChangedEquipmentSlotsDelegate ChangedEquipmentSlotsDelegate;
 
+	/**
+	 * Subscribe to changes of a single equipment slot. Subscribers are only called if their slot changed.
+	 *
+	 * @param Slot The equipment slot.
+	 * @param Delegate Called with the slot after it changed.
+	 *
+	 * @return The handle used to unsubscribe.
+	 */
+	FDelegateHandle SubscribeEquipmentSlot(const int Slot, FSlotSubscriptionDelegate::FDelegate&& Delegate);
+
+	/**
+	 * Remove a subscription created with SubscribeEquipmentSlot.
+	 *
+	 * @param Slot The equipment slot.
+	 * @param Handle The handle returned by SubscribeEquipmentSlot.
+	 */
+	void UnsubscribeEquipmentSlot(const int Slot, const FDelegateHandle& Handle);
+
 	/**
 	 * Delegate used to add functionality after an MaxEquipmentStackSize was set.
 	 */
 	UPROPERTY(BlueprintAssignable, BlueprintCallable)
 	FSetMaxEquipmentStackSizeSuccessDelegate SetMaxEquipmentStackSizeSuccessDelegate;
+
+	/**
+	 * Delegate used to add functionality after the aggregated equipment stats changed. Deltas contains the change of every affected stat total.
+	 */
+	UPROPERTY(BlueprintAssignable, BlueprintCallable)
+	FChangedEquipmentStatTotalsDelegate ChangedEquipmentStatTotalsDelegate;
+
+	/**
+	 * Delegate used to add functionality after an equipment loadout was saved.
+	 */
+	UPROPERTY(BlueprintAssignable, BlueprintCallable)
+	FEquipmentLoadoutSuccessDelegate SaveEquipmentLoadoutSuccessDelegate;
+
+	/**
+	 * Delegate used to add functionality after an equipment loadout was removed.
+	 */
+	UPROPERTY(BlueprintAssignable, BlueprintCallable)
+	FEquipmentLoadoutSuccessDelegate RemoveEquipmentLoadoutSuccessDelegate;
+
+	/**
+	 * Delegate used to add functionality after an equipment loadout was applied.
+	 */
+	UPROPERTY(BlueprintAssignable, BlueprintCallable)
+	FApplyEquipmentLoadoutSuccessDelegate ApplyEquipmentLoadoutSuccessDelegate;
 	
 	/**
 	 * Get the EquipmentSlots.
@@ -323,8 +588,95 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Inventory System")
 	FEquipmentSlot GetEquipmentSlot(int Slot) const;
 
+	/**
+	 * Get an EquipmentSlot from the slot cache. The slot is only rebuilt from the equipment arrays if it changed since the last call.
+	 *
+	 * @param Slot The target slot index
+	 *
+	 * @return The EquipmentSlot.
+	 */
+	FEquipmentSlot GetCachedEquipmentSlot(const int Slot) const;
+
+	/**
+	 * Get the generation of an equipment slot. The generation changes every time the slot changes, so UI can skip work if it is unchanged.
+	 *
+	 * @param Slot The target slot index
+	 *
+	 * @return The generation or INDEX_NONE if the slot is not tracked. Treat INDEX_NONE as always changed.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Inventory System")
+	int GetEquipmentSlotGeneration(const int Slot) const;
+
+	/**
+	 * Get the equipment types an asset can be equipped to. Parsed once per asset from the asset registry.
+	 * Returned by value as later lookups can grow the cache.
+	 *
+	 * @param Asset The item asset.
+	 *
+	 * @return The equipment types of the asset. Empty if the asset is no equipment or not found in the asset registry.
+	 */
+	TArray<FPrimaryAssetId> GetAssetEquipmentTypes(const FPrimaryAssetId& Asset) const;
+
+	/**
+	 * Get the base stats of an equipment asset. Parsed once per asset from the asset registry.
+	 *
+	 * @param Asset The item asset.
+	 *
+	 * @return The base stats of the asset. Empty if the asset has none.
+	 */
+	FItemProperties GetAssetBaseStats(const FPrimaryAssetId& Asset) const;
+
+	/**
+	 * Get the sum of a numeric stat over all equipped items. Base stats of the assets and dynamic stats are both included.
+	 *
+	 * @param PropertyName The name of the stat.
+	 *
+	 * @return The total or 0 if no equipped item has this stat.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Inventory System")
+	double GetEquipmentStatTotal(const FName PropertyName) const;
+
+	/**
+	 * Get the highest value of a numeric stat over all equipped items.
+	 *
+	 * @param PropertyName The name of the stat.
+	 *
+	 * @return The highest value or 0 if no equipped item has this stat.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Inventory System")
+	double GetEquipmentStatMax(const FName PropertyName) const;
+
+	/**
+	 * Get the sums of all numeric stats over all equipped items.
+	 *
+	 * @return The totals by stat name.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Inventory System")
+	TMap<FName, double> GetEquipmentStatTotals() const;
+
+	/**
+	 * Get all equipment slots an asset can be equipped to.
+	 *
+	 * @param Asset The item asset.
+	 *
+	 * @return The compatible equipment slots in EquipmentTypes order.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Inventory System")
+	TArray<int> GetCompatibleEquipmentSlots(const FPrimaryAssetId& Asset) const;
+
+	/**
+	 * Get all inventory slots holding an item that can be equipped to the given equipment slot.
+	 *
+	 * @param EquipmentSlot The equipment slot.
+	 *
+	 * @return The compatible inventory slots in ascending order.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Inventory System")
+	TArray<int> GetCompatibleInventorySlots(const int EquipmentSlot);
+
 	/**
 	 * Set, remove or add equipment type of given slot if valid and in range. This will unequip an item if the new equipment type is different!
+	 * The slot must be between 0 and UInventorySystemSettings::MaxEquipmentSlot.
 	 *
 	 * @param Slot
 	 * @param EquipmentType 
@@ -394,6 +746,17 @@ public:
 	void PickUpItemDrop(AItemDrop* const& Item, const bool bCanStack = true);
 	virtual void PickUpItemDrop_Implementation(AItemDrop* const& Item, const bool bCanStack = true);
 
+	/**
+	 * Server only. Pick up an ItemDrop in a single call without going through the PickUp and PickUpItemDrop RPCs.
+	 * Adds the item, broadcasts the pick up delegates and finishes the drop with AfterPickUpEvent.
+	 *
+	 * @param Item       The ItemDrop to pick up.
+	 * @param bCanStack  Specifies if stacking is allowed (default is true).
+	 * @return True if at least part of the item was added to the inventory.
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly, Category = "Inventory System")
+	bool PickUpItemDropDirect(AItemDrop* Item, const bool bCanStack = true);
+
 	/**
 	 * Internal with return. Dont use for implementation!!! Pick up an ItemDrop and destroy it after successfully adding it to the inventory.
 	 *
@@ -403,6 +766,39 @@ public:
 	 */
 	bool PickUpItemDropInternal(AItemDrop* const& Item, const bool bCanStack, TArray<int>& ChangedSlots);
 
+	/**
+	 * Pick up all item drops within a radius around the owner in a single server operation. All drops are added in one pass,
+	 * emptied drops are handled by their AfterPickUpEvent and only one change set is broadcast and replicated.
+	 * Use this for auto loot instead of calling AItemDrop::PickUp for every drop.
+	 *
+	 * @param Radius     The pick up radius around the pawn of the owning PlayerState or the owner itself. Clamped to UInventorySystemSettings::MaxItemDropPickUpRadius.
+	 * @param Query      Filter for asset and stackability of the drops.
+	 * @param bCanStack  Specifies if stacking is allowed (default is true).
+	 */
+	UFUNCTION(Server, WithValidation, Reliable, BlueprintCallable, Category = "Inventory System")
+	void PickUpItemDropsInRadius(const float Radius, const FItemDropQuery Query, const bool bCanStack = true);
+	virtual void PickUpItemDropsInRadius_Implementation(const float Radius, const FItemDropQuery Query, const bool bCanStack = true);
+
+	/**
+	 * Get the location used for radius pick ups. This is the pawn of the owning PlayerState or the owner itself.
+	 *
+	 * @return The pick up location.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Inventory System")
+	FVector GetPickUpLocation() const;
+
+	/**
+	 * Pick up a lightweight item drop. The drop is promoted to an AItemDrop by UItemDropSubsystem and picked up directly.
+	 * Drops further than UInventorySystemSettings::MaxItemDropPickUpRadius from GetPickUpLocation are rejected.
+	 * A remainder that does not fit into the inventory is added back as a new lightweight drop.
+	 *
+	 * @param Id         The id of the lightweight drop.
+	 * @param bCanStack  Specifies if stacking is allowed (default is true).
+	 */
+	UFUNCTION(Server, WithValidation, Reliable, BlueprintCallable, Category = "Inventory System")
+	void PickUpLightweightItemDrop(const int Id, const bool bCanStack = true);
+	virtual void PickUpLightweightItemDrop_Implementation(const int Id, const bool bCanStack = true);
+
 	/**
 	 * Add an item to a specified equipment slot. This should only be used for items outside the inventory.
 	 * Please keep track of your amount and stack size as this will always reset the amount to the max amount allowed for the slot
@@ -477,6 +873,37 @@ public:
 	 */
 	virtual TArray<int> AddItemToComponentInternal(const int Slot, UItemContainerComponent* ItemContainerComponent, int& Amount, const bool bCanStack = false, const bool bIsEquipment = false, const bool bRevertWhenFull = true) override;
 
+	/**
+	 * Save the currently equipped items as loadout. An existing loadout with the same name is replaced.
+	 *
+	 * @param LoadoutName The unique name of the loadout.
+	 */
+	UFUNCTION(Server, WithValidation, Reliable, BlueprintCallable, Category = "Inventory System")
+	void SaveEquipmentLoadout(const FName LoadoutName);
+	virtual void SaveEquipmentLoadout_Implementation(const FName LoadoutName);
+
+	/**
+	 * Remove a saved loadout. Equipped items are not changed.
+	 *
+	 * @param LoadoutName The name of the loadout.
+	 */
+	UFUNCTION(Server, WithValidation, Reliable, BlueprintCallable, Category = "Inventory System")
+	void RemoveEquipmentLoadout(const FName LoadoutName);
+	virtual void RemoveEquipmentLoadout_Implementation(const FName LoadoutName);
+
+	/**
+	 * Switch to a saved loadout in a single server operation. All moves between inventory and equipment are planned first and
+	 * applied at once with one change broadcast. Nothing is changed if the loadout has more than one entry for an equipment
+	 * slot, an entry's item is missing or the replaced items do not fit into the inventory. Entries not fitting the equipment
+	 * type of their slot are skipped and their equipment slot is not changed.
+	 *
+	 * @param LoadoutName The name of the loadout.
+	 * @param bCanStack Stack stackable items when equipping and when adding replaced items to the inventory.
+	 */
+	UFUNCTION(Server, WithValidation, Reliable, BlueprintCallable, Category = "Inventory System")
+	void ApplyEquipmentLoadout(const FName LoadoutName, const bool bCanStack = true);
+	virtual void ApplyEquipmentLoadout_Implementation(const FName LoadoutName, const bool bCanStack = true);
+
 	/**
 	 * Collect all items from this container and add them to the specified ItemContainerComponent.
 	 *
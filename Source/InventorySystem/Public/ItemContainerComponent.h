@@ -3,6 +3,7 @@
 #pragma once
 
 #include "InventorySlots.h"
+#include "ItemContainerQuery.h"
 #include "ItemDataAsset.h"
 #include "Components/ActorComponent.h"
 #include <atomic>
@@ -57,6 +58,30 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FSetMaxStackSizeSuccessDelegate, boo
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FSetInventorySizeSuccessDelegate, bool, bSuccess);
 
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FSortItemsSuccessDelegate, bool, bSuccess, const TArray<int>&, Slots);
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FConsolidateStacksSuccessDelegate, bool, bSuccess, const TArray<int>&, Slots);
+
+// C++ only delegate for slot subscriptions. Only called for the subscribed slot.
+DECLARE_MULTICAST_DELEGATE_OneParam(FSlotSubscriptionDelegate, int /* Slot */);
+
+// C++ only delegate called once a component finished its setup in BeginPlay, on server and clients.
+DECLARE_MULTICAST_DELEGATE_OneParam(FItemContainerComponentReadyDelegate, UItemContainerComponent* /* Component */);
+
+/**
+ * Keys used to order items when sorting an item container.
+ */
+UENUM(BlueprintType)
+enum class EItemContainerSortKey : uint8
+{
+	// Order by primary asset id (type and name).
+	Asset,
+	// Order by the value of a dynamic item property. Numeric values are compared as numbers.
+	PropertyValue,
+	// Order by item amount.
+	Amount
+};
+
 /**
  * @class UItemContainerComponent
  * @brief Handles item storage, management, and interaction within an item container, including addition, removal, and property adjustment of items.
@@ -195,6 +220,78 @@ protected:
 	UPROPERTY(Replicated, BlueprintReadOnly, EditAnywhere, Category = "Inventory System|Settings", meta = (ClampMin="0", EditCondition = "!bHasBegunPlayEditor"))
 	int InventorySize = 0;
 
+	/**
+	 * Internal use only. Slots by asset. Maintained incrementally through ChangedInventorySlotsDelegate.
+	 */
+	TMap<FPrimaryAssetId, TSet<int>> QueryIndexSlotsByAsset;
+
+	/**
+	 * Internal use only. Slots by primary asset type.
+	 */
+	TMap<FPrimaryAssetType, TSet<int>> QueryIndexSlotsByAssetType;
+
+	/**
+	 * Internal use only. Slots by dynamic property name.
+	 */
+	TMap<FName, TSet<int>> QueryIndexSlotsByProperty;
+
+	/**
+	 * Internal use only. Numeric dynamic property values by property name and slot.
+	 */
+	TMap<FName, TMap<int, double>> QueryIndexNumericValues;
+
+	/**
+	 * Internal use only. Values sorted ascending as (value, slot) for the properties marked as indexed in the settings.
+	 */
+	TMap<FName, TArray<TPair<double, int>>> QueryIndexSortedValues;
+
+	/**
+	 * Internal use only. Indexed asset and property names per slot, used to remove stale entries.
+	 */
+	TMap<int, TPair<FPrimaryAssetId, TArray<FName>>> QueryIndexEntries;
+
+	/**
+	 * Internal use only. Update the query indexes for the changed slots.
+	 *
+	 * @param Slots The changed slots.
+	 */
+	UFUNCTION()
+	virtual void UpdateQueryIndex(const TArray<int>& Slots);
+
+	/**
+	 * Internal use only. Rebuild all query indexes from the inventory arrays.
+	 */
+	void RebuildQueryIndex();
+
+	/**
+	 * Internal use only. Remove a slot from all query indexes.
+	 *
+	 * @param Slot The slot to remove.
+	 */
+	void RemoveSlotFromQueryIndex(const int Slot);
+
+	/**
+	 * Internal use only. Add a slot with its content to all query indexes.
+	 *
+	 * @param Slot			The slot to add.
+	 * @param Asset			The asset in the slot.
+	 * @param DynamicStats	The dynamic stats of the slot.
+	 */
+	void AddSlotToQueryIndex(const int Slot, const FPrimaryAssetId& Asset, const FItemProperties& DynamicStats);
+
+	/**
+	 * Internal use only. Subscribers per inventory slot. See SubscribeInventorySlot.
+	 */
+	TMap<int, FSlotSubscriptionDelegate> InventorySlotSubscriptions;
+
+	/**
+	 * Internal use only. Route changed slots to their subscribers only.
+	 *
+	 * @param Slots The changed slots.
+	 */
+	UFUNCTION()
+	virtual void DispatchInventorySlotSubscriptions(const TArray<int>& Slots);
+
 public:
 	/**
 	 * Delegate used to add functionality after the item swap method started.
@@ -310,6 +407,30 @@ public:
 	UPROPERTY(BlueprintAssignable, BlueprintCallable)
 	FChangedInventorySlotsDelegate ChangedInventorySlotsDelegate;
 
+	/**
+	 * Subscribe to changes of a single inventory slot. Unlike ChangedInventorySlotsDelegate, subscribers are only called if their slot changed,
+	 * so the cost of a change depends on the changed slots and not on the number of slot widgets.
+	 *
+	 * @param Slot The inventory slot.
+	 * @param Delegate Called with the slot after it changed.
+	 *
+	 * @return The handle used to unsubscribe.
+	 */
+	FDelegateHandle SubscribeInventorySlot(const int Slot, FSlotSubscriptionDelegate::FDelegate&& Delegate);
+
+	/**
+	 * Remove a subscription created with SubscribeInventorySlot.
+	 *
+	 * @param Slot The inventory slot.
+	 * @param Handle The handle returned by SubscribeInventorySlot.
+	 */
+	void UnsubscribeInventorySlot(const int Slot, const FDelegateHandle& Handle);
+
+	/**
+	 * Called for every component that finished its setup in BeginPlay. Widgets use this instead of polling for their component.
+	 */
+	static FItemContainerComponentReadyDelegate ItemContainerComponentReadyDelegate;
+
 	/**
 	 * Delegate used to add functionality after MaxStackSize was set.
 	 */
@@ -321,6 +442,18 @@ public:
 	 */
 	UPROPERTY(BlueprintAssignable, BlueprintCallable)
 	FSetInventorySizeSuccessDelegate SetInventorySizeSuccessDelegate;
+
+	/**
+	 * Delegate used to add functionality after the items were sorted.
+	 */
+	UPROPERTY(BlueprintAssignable, BlueprintCallable)
+	FSortItemsSuccessDelegate SortItemsSuccessDelegate;
+
+	/**
+	 * Delegate used to add functionality after partial stacks were consolidated.
+	 */
+	UPROPERTY(BlueprintAssignable, BlueprintCallable)
+	FConsolidateStacksSuccessDelegate ConsolidateStacksSuccessDelegate;
 	
 	/**
 	 * Boolean indicating whether the component is currently processing another request.
@@ -383,6 +516,40 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Inventory System")
 	FInventorySlot GetInventorySlot(const int Slot) const;
 
+	/**
+	 * Find slots by asset, asset type, property existence or a numeric property range. Uses secondary indexes instead of iterating all slots.
+	 *
+	 * @param Query	The filters to apply. All set filters are combined.
+	 *
+	 * @return The matching slots in ascending order.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Inventory System")
+	TArray<int> QueryInventorySlots(const FItemContainerQuery& Query);
+
+	/**
+	 * Find slots whose numeric property value is within a range. Uses the sorted index if the property is marked as indexed in the settings.
+	 *
+	 * @param PropertyName	The name of the dynamic item property.
+	 * @param MinValue		Inclusive lower bound.
+	 * @param MaxValue		Inclusive upper bound.
+	 *
+	 * @return The matching slots ordered by value ascending.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Inventory System")
+	TArray<int> GetSlotsInPropertyRange(const FName PropertyName, const double MinValue, const double MaxValue);
+
+	/**
+	 * Get the slots with the highest or lowest numeric property values. Uses the sorted index if the property is marked as indexed in the settings.
+	 *
+	 * @param PropertyName	The name of the dynamic item property.
+	 * @param Count			The maximum number of slots to return.
+	 * @param bHighest		Return the highest values first, otherwise the lowest.
+	 *
+	 * @return Up to Count slots ordered by value.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Inventory System")
+	TArray<int> GetTopSlotsByProperty(const FName PropertyName, const int Count, const bool bHighest = true);
+
 	/**
 	 * Check if a slot has a specific item property.
 	 *
@@ -585,6 +752,48 @@ public:
 	void CollectAllItems(UItemContainerComponent* ItemContainerComponent, const bool bCanStack = true);
 	virtual void CollectAllItems_Implementation(UItemContainerComponent* ItemContainerComponent, const bool bCanStack = true);
 
+	/**
+	 * Sort and compact all items in this container in a single server operation. Items are moved to the slots 1..N in the requested order
+	 * and only slots whose content actually changed are reported and replicated. Use this instead of chaining SwapItems calls.
+	 *
+	 * @param SortKey		The key used to order the items.
+	 * @param PropertyName	The dynamic item property used when SortKey is PropertyValue. Items without this property are placed last.
+	 * @param bDescending	Sort in descending order.
+	 * @param bRestack		Merge partial stacks of stackable items with the same asset and dynamic stats before sorting.
+	 */
+	UFUNCTION(Server, WithValidation, Reliable, BlueprintCallable, Category = "Inventory System")
+	void SortItems(const EItemContainerSortKey SortKey = EItemContainerSortKey::Asset, const FName PropertyName = NAME_None, const bool bDescending = false, const bool bRestack = true);
+	virtual void SortItems_Implementation(const EItemContainerSortKey SortKey = EItemContainerSortKey::Asset, const FName PropertyName = NAME_None, const bool bDescending = false, const bool bRestack = true);
+
+	/**
+	 * Merge all partial stacks of stackable items with the same asset and dynamic stats in one pass. Stacks are filled in slot order,
+	 * items stay in their slots and emptied slots are freed. Use this instead of merging stacks pair by pair with SwapItems.
+	 */
+	UFUNCTION(Server, WithValidation, Reliable, BlueprintCallable, Category = "Inventory System")
+	void ConsolidateStacks();
+	virtual void ConsolidateStacks_Implementation();
+
+	/**
+	 * Internal use only. Dont use for implementation!!! Merge partial stacks of stackable items with the same asset and dynamic stats.
+	 * Stacks are filled front to back by slot, emptied entries are removed from the given array.
+	 *
+	 * @param InventorySlots	The slots to consolidate.
+	 *
+	 * @return False if the slots could not be consolidated because the AssetManager is not initialized.
+	 */
+	bool ConsolidateInventorySlots(TArray<FInventorySlot>& InventorySlots) const;
+
+	/**
+	 * Internal with return. Dont use for implementation!!! Replace the whole inventory with the given slots in one pass.
+	 * Only the entries of changed slots are written. Entries of removed slots are reused for added slots, the rest is removed with swaps,
+	 * so only the touched indices of the replicated arrays are sent.
+	 *
+	 * @param NewInventorySlots	The new content of the inventory. Slots must be unique and within the inventory size.
+	 *
+	 * @return The slots that changed, including slots that are now empty.
+	 */
+	TArray<int> ApplyInventorySlots(const TArray<FInventorySlot>& NewInventorySlots);
+
 	/**
 	 * Internal method used to get the global config value or a default set in this component.
 	 * 
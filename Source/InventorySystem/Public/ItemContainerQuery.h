@@ -0,0 +1,72 @@
+﻿// © 2024 Daniel Münch. All Rights Reserved
+
+#pragma once
+
+#include "ItemContainerQuery.generated.h"
+
+#define LOCTEXT_NAMESPACE "InventorySystem"
+
+/**
+ * @struct FItemContainerQuery
+ * @brief Describes a filter used to find slots in an item container without iterating all inventory slots.
+ *
+ * All set filters are combined. Unset filters (invalid asset, invalid asset type, None property name) are ignored.
+ * Queries are answered by the secondary indexes of the container, which are updated with every changed slot.
+ *
+ * General Usage:
+ * - Fill the filters you need and pass the query to UItemContainerComponent::QueryInventorySlots.
+ *
+ * Example Use Case:
+ * @code
+ * // All consumables with Healing >= 50
+ * FItemContainerQuery Query;
+ * Query.AssetType = FPrimaryAssetType(TEXT("Consumable"));
+ * Query.PropertyName = TEXT("Healing");
+ * Query.bUseValueRange = true;
+ * Query.MinValue = 50.0;
+ * TArray<int> Slots = Inventory->QueryInventorySlots(Query);
+ * @endcode
+ */
+USTRUCT(BlueprintType, Category = "Inventory System")
+struct INVENTORYSYSTEM_API FItemContainerQuery
+{
+	GENERATED_BODY()
+
+	/**
+	 * Only return slots containing this asset. Ignored if invalid.
+	 */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "Inventory System")
+	FPrimaryAssetId Asset;
+
+	/**
+	 * Only return slots containing an asset of this primary asset type. Ignored if invalid.
+	 */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "Inventory System")
+	FPrimaryAssetType AssetType;
+
+	/**
+	 * Only return slots whose dynamic stats contain a property with this name. Ignored if None.
+	 */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "Inventory System")
+	FName PropertyName;
+
+	/**
+	 * Only return slots whose property value is numeric and within MinValue and MaxValue (inclusive). Requires PropertyName.
+	 */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "Inventory System")
+	bool bUseValueRange = false;
+
+	/**
+	 * Inclusive lower bound of the property value.
+	 */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "Inventory System", meta = (EditCondition = "bUseValueRange"))
+	double MinValue = TNumericLimits<double>::Lowest();
+
+	/**
+	 * Inclusive upper bound of the property value.
+	 */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "Inventory System", meta = (EditCondition = "bUseValueRange"))
+	double MaxValue = TNumericLimits<double>::Max();
+};
+
+#undef LOCTEXT_NAMESPACE
@@ -3,6 +3,7 @@
 #pragma once
 
 #include "Engine/DataAsset.h"
+#include "Engine/StaticMesh.h"
 #include "Engine/Texture2D.h"
 #include "ItemAssetInterface.h"
 #include "ItemDataAsset.generated.h"
@@ -106,6 +107,12 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Inventory System|Visuals", meta = (AssetBundles = "Visuals"))
 	UTexture2D* Icon;
 
+	/**
+	 * The mesh used to render lightweight item drops of this item in the game world.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Inventory System|Visuals", meta = (AssetBundles = "Visuals"))
+	TSoftObjectPtr<UStaticMesh> DropMesh;
+
 	// Implement Interface
 	
 	/**
@@ -24,6 +24,7 @@ class UInventorySystemComponent;
  * - Place in the game world as a spawnable actor for items that can be picked up.
  * - Configure properties such as item data, stacking behavior, and visual representation through the editor or at runtime.
  * - If a different item type is utilized, it is required to build a new AItemDrop; the only variables that can be altered are the amount and dynamic stats.
+ * - Drops are net dormant. Call FlushItemData after changing the amount or dynamic stats outside of a pick up.
  *
  * Example Use Case:
  * @code
@@ -51,6 +52,17 @@ protected:
 	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "Inventory System|Settings")
 	bool bDestroyAfterPickUp = true;
 
+	/**
+	 * Internal use only. Boolean indicating whether the drop is idle in the pool of UItemDropSubsystem.
+	 */
+	UPROPERTY(BlueprintReadOnly, VisibleAnywhere, Category = "Inventory System|Settings")
+	bool bIsPooled = false;
+
+	/**
+	 * Internal use only. Boolean indicating whether the item data was already validated by UItemDropSubsystem and InitializeItemDrop can skip the checks.
+	 */
+	bool bIsItemDataValidated = false;
+
 	/**
 	 * Internal use only. Boolean indicating whether other item properties are allowed to be edited.
 	 */
@@ -80,6 +92,16 @@ protected:
 	 */
 	virtual void BeginPlay() override;
 
+	/**
+	 * Internal use only. Check the setup, roll the random amount and add the drop to UItemDropSubsystem. Called on BeginPlay and when reused from the pool.
+	 */
+	void InitializeItemDrop();
+
+	/**
+	 * Keep the grid cell in UItemDropSubsystem up to date when the drop moved.
+	 */
+	void HandleRootTransformUpdated(USceneComponent* UpdatedComponent, EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport);
+
 	AItemDrop();
 
 #if WITH_EDITORONLY_DATA
@@ -89,6 +111,23 @@ protected:
 	UPROPERTY()
 	UBillboardComponent* SpriteComponent;
 
+	/**
+	 * Internal use only. Billboard texture shared by all item drops. Imported once per editor session and kept in the root set.
+	 */
+	static TWeakObjectPtr<UTexture2D> SpriteTexture;
+
+	/**
+	 * Internal use only. Boolean indicating whether the import of SpriteTexture was already tried.
+	 */
+	static bool bIsSpriteTextureImported;
+
+	/**
+	 * Internal use only. Get the shared billboard texture and import it on first use.
+	 *
+	 * @return The texture or nullptr if the import failed.
+	 */
+	static UTexture2D* GetSpriteTexture();
+
 	/**
 	 * Contains data for this item. Please don't use this directly in runtime as it will be empty. Use InventoryAsset instead and load it with the AssetManager.
 	 */
@@ -117,14 +156,14 @@ public:
 	 * @param PropertyChangedEvent 
 	 */
 	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
 
 	/**
-	 *	Set editor begun play.
+	 *	Remove the drop from UItemDropSubsystem and set editor begun play.
 	 *
 	 * @param EndPlayReason 
 	 */
 	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
-#endif
 	
 	/**
 	 * Called when the item is constructed in the world.
@@ -165,6 +204,16 @@ public:
 	UFUNCTION(Server, Reliable, WithValidation, BlueprintCallable, Category = "Inventory System")
 	void PickUp(UInventorySystemComponent* InventorySystemComponent, const bool bCanStack = true);
 	void PickUp_Implementation(UInventorySystemComponent* InventorySystemComponent, const bool bCanStack = true);
+
+	/**
+	 * Server only. Pick up the item in a single call without the PickUp and PickUpItemDrop RPCs, for example from server side interaction or overlap logic.
+	 *
+	 * @param InventorySystemComponent Component this item should be added to.
+	 * @param bCanStack Indicates whether the item can stack if already present in the inventory.
+	 * @return True if at least part of the item was added to the inventory.
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly, Category = "Inventory System")
+	bool PickUpDirect(UInventorySystemComponent* InventorySystemComponent, const bool bCanStack = true);
 	
 	/**
 	 * This after pick up event allows you to add functionality before the object gets destroyed. Make sure to always call the parent function! If the object should be kept after pick up with amount 0 use the bDestroyAfterPickUp flag.
@@ -177,8 +226,21 @@ public:
 	/**
 	 * Contains data for this item.
 	 */
-	UPROPERTY(Replicated, BlueprintReadOnly, EditInstanceOnly, Category = "Inventory System|Item", meta = (EditCondition = "AllowItemAssetEdit", EditConditionHides, ToolTip = "Select the ItemData or ItemEquipmentAsset you specified",  ExposeOnSpawn = "true", AllowedClasses = "/Script/InventorySystem.ItemDataAsset", ExactClass = false))
+	UPROPERTY(ReplicatedUsing = OnRep_InventoryAsset, BlueprintReadOnly, EditInstanceOnly, Category = "Inventory System|Item", meta = (EditCondition = "AllowItemAssetEdit", EditConditionHides, ToolTip = "Select the ItemData or ItemEquipmentAsset you specified",  ExposeOnSpawn = "true", AllowedClasses = "/Script/InventorySystem.ItemDataAsset", ExactClass = false))
 	FPrimaryAssetId InventoryAsset;
+
+	/**
+	 * Set up the drop again on clients when a pooled drop is reused for another item.
+	 */
+	UFUNCTION()
+	void OnRep_InventoryAsset();
+
+	/**
+	 * Called on the server and on clients when the drop shows a new item. Runs after BeginPlay and every time a pooled drop is reused.
+	 * Build item dependent visuals here instead of in BeginPlay.
+	 */
+	UFUNCTION(BlueprintImplementableEvent, Category = "Inventory System")
+	void ItemChangedEvent();
 	
 	/**
 	 * Amount for the item.
@@ -198,6 +260,59 @@ public:
 	 * @return 
 	 */
 	int GetStackSizeConfig() const;
+
+	/**
+	 * Check if the item of this drop can stack. Only valid after BeginPlay.
+	 *
+	 * @return True if the item can stack.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Inventory System")
+	bool CanStack() const;
+
+	/**
+	 * Check if the drop is processing a pick up request.
+	 *
+	 * @return True while a pick up is processed.
+	 */
+	bool IsProcessing() const;
+
+	/**
+	 * Check if the drop is idle in the pool of UItemDropSubsystem.
+	 *
+	 * @return True while pooled.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Inventory System")
+	bool IsPooled() const;
+
+	/**
+	 * Replicate changed item data of the net dormant drop once. Call after changing Amount or DynamicStats outside of a pick up.
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly, Category = "Inventory System")
+	void FlushItemData();
+
+	/**
+	 * Internal use only. Reset the drop to a new item and show it again. Called by UItemDropSubsystem::SpawnItemDrop.
+	 * Enables movement replication, so clients move the reused drop and update its grid cell. Clients set the drop up again in OnRep_InventoryAsset.
+	 *
+	 * @param NewInventoryAsset	The item of the drop.
+	 * @param NewAmount			The amount of the item.
+	 * @param NewDynamicStats	The dynamic stats of the item.
+	 * @param Transform			The new transform of the drop.
+	 */
+	virtual void ActivatePooled(const FPrimaryAssetId& NewInventoryAsset, const int NewAmount, const FItemProperties& NewDynamicStats, const FTransform& Transform);
+
+	/**
+	 * Internal use only. Clear the item, hide the drop and make it dormant. Called by UItemDropSubsystem::ReleaseItemDrop.
+	 */
+	virtual void DeactivatePooled();
+
+	/**
+	 * Internal use only. Skip InternalChecks and the random amount on the next initialization because the item data was validated in advance.
+	 * Called by UItemDropSubsystem::SpawnItemDrops before BeginPlay or ActivatePooled.
+	 *
+	 * @param bCanStack Cached stackability of the item.
+	 */
+	void MarkItemDataValidated(const bool bCanStack);
 };
 
 #undef LOCTEXT_NAMESPACE
\ No newline at end of file
@@ -0,0 +1,103 @@
+﻿// © 2024 Daniel Münch. All Rights Reserved
+
+#pragma once
+
+#include "ItemProperties.h"
+#include "Net/Serialization/FastArraySerializer.h"
+#include "ItemDropInstance.generated.h"
+
+#define LOCTEXT_NAMESPACE "InventorySystem"
+
+class AItemDropRegion;
+
+/**
+ * @struct FItemDropInstance
+ * @brief A lightweight item drop without an actor, stored and replicated by an AItemDropRegion.
+ *
+ * Lightweight drops are rendered with instanced static meshes and promoted to a real AItemDrop by UItemDropSubsystem
+ * when a player interacts with them.
+ *
+ * Example Use Case:
+ * @code
+ * int Id = GetWorld()->GetSubsystem<UItemDropSubsystem>()->AddLightweightItemDrop(Asset, 10, FItemProperties(), Transform);
+ * @endcode
+ */
+USTRUCT(BlueprintType, Category = "Inventory System")
+struct INVENTORYSYSTEM_API FItemDropInstance : public FFastArraySerializerItem
+{
+	GENERATED_BODY()
+
+	/**
+	 * Unique id of the drop in its world. Used to pick up or promote the drop.
+	 */
+	UPROPERTY(BlueprintReadOnly, Category = "Inventory System")
+	int Id = INDEX_NONE;
+
+	/**
+	 * The item of the drop.
+	 */
+	UPROPERTY(BlueprintReadOnly, Category = "Inventory System")
+	FPrimaryAssetId InventoryAsset;
+
+	/**
+	 * The amount of the item.
+	 */
+	UPROPERTY(BlueprintReadOnly, Category = "Inventory System")
+	int Amount = 1;
+
+	/**
+	 * The dynamic stats of the item.
+	 */
+	UPROPERTY(BlueprintReadOnly, Category = "Inventory System")
+	FItemProperties DynamicStats;
+
+	/**
+	 * The world transform of the drop.
+	 */
+	UPROPERTY(BlueprintReadOnly, Category = "Inventory System")
+	FTransform Transform;
+};
+
+/**
+ * @struct FItemDropInstanceArray
+ * @brief Fast array of the lightweight drops of an AItemDropRegion. Only added, changed and removed drops are replicated.
+ */
+USTRUCT()
+struct INVENTORYSYSTEM_API FItemDropInstanceArray : public FFastArraySerializer
+{
+	GENERATED_BODY()
+
+	/**
+	 * The drops of the region.
+	 */
+	UPROPERTY()
+	TArray<FItemDropInstance> Items;
+
+	/**
+	 * Internal use only. The region owning this array.
+	 */
+	UPROPERTY(NotReplicated)
+	TObjectPtr<AItemDropRegion> Owner;
+
+	void PostReplicatedAdd(const TArrayView<int32>& AddedIndices, int32 FinalSize);
+
+	void PostReplicatedChange(const TArrayView<int32>& ChangedIndices, int32 FinalSize);
+
+	void PreReplicatedRemove(const TArrayView<int32>& RemovedIndices, int32 FinalSize);
+
+	bool NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParams)
+	{
+		return FastArrayDeltaSerialize<FItemDropInstance, FItemDropInstanceArray>(Items, DeltaParams, *this);
+	}
+};
+
+template<>
+struct TStructOpsTypeTraits<FItemDropInstanceArray> : public TStructOpsTypeTraitsBase2<FItemDropInstanceArray>
+{
+	enum
+	{
+		WithNetDeltaSerializer = true,
+	};
+};
+
+#undef LOCTEXT_NAMESPACE
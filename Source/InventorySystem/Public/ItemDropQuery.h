@@ -0,0 +1,55 @@
+﻿// © 2024 Daniel Münch. All Rights Reserved
+
+#pragma once
+
+#include "ItemDropQuery.generated.h"
+
+#define LOCTEXT_NAMESPACE "InventorySystem"
+
+/**
+ * Stackability filter of an item drop query.
+ */
+UENUM(BlueprintType)
+enum class EItemDropStackFilter : uint8
+{
+	// Return stackable and not stackable drops.
+	Any,
+	// Only return drops of stackable items.
+	Stackable,
+	// Only return drops of not stackable items.
+	NotStackable
+};
+
+/**
+ * @struct FItemDropQuery
+ * @brief Describes a filter used to find item drops around a location with UItemDropSubsystem.
+ *
+ * All set filters are combined. An invalid asset is ignored.
+ *
+ * Example Use Case:
+ * @code
+ * // The 5 nearest stackable drops within 10m
+ * FItemDropQuery Query;
+ * Query.StackFilter = EItemDropStackFilter::Stackable;
+ * TArray<AItemDrop*> ItemDrops = GetWorld()->GetSubsystem<UItemDropSubsystem>()->GetNearestItemDrops(Location, 5, 1000.f, Query);
+ * @endcode
+ */
+USTRUCT(BlueprintType, Category = "Inventory System")
+struct INVENTORYSYSTEM_API FItemDropQuery
+{
+	GENERATED_BODY()
+
+	/**
+	 * Only return drops of this asset. Ignored if invalid.
+	 */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "Inventory System")
+	FPrimaryAssetId Asset;
+
+	/**
+	 * Only return drops matching this stackability.
+	 */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "Inventory System")
+	EItemDropStackFilter StackFilter = EItemDropStackFilter::Any;
+};
+
+#undef LOCTEXT_NAMESPACE
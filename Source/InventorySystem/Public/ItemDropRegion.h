@@ -0,0 +1,128 @@
+﻿// © 2024 Daniel Münch. All Rights Reserved
+
+#pragma once
+
+#include "ItemDropInstance.h"
+#include "GameFramework/Actor.h"
+#include "ItemDropRegion.generated.h"
+
+#define LOCTEXT_NAMESPACE "InventorySystem"
+
+class UInstancedStaticMeshComponent;
+
+/**
+ * @class AItemDropRegion
+ * @brief Replicates and renders all lightweight item drops of one region of the UItemDropSubsystem grid.
+ *
+ * Regions are spawned by UItemDropSubsystem on the server. One actor channel replicates all drops of a region as a fast array and
+ * clients only receive regions within UInventorySystemSettings::LightweightItemDropNetCullDistance. Drops are rendered with one
+ * instanced static mesh per item, using UItemDataAsset::DropMesh. Dedicated servers do not render.
+ *
+ * General Usage:
+ * - Do not spawn or place this actor. Use the lightweight drop functions of UItemDropSubsystem.
+ */
+UCLASS(NotBlueprintable, NotPlaceable, Category = "Inventory System", ClassGroup = ("Inventory System"))
+class INVENTORYSYSTEM_API AItemDropRegion : public AActor
+{
+	GENERATED_BODY()
+
+protected:
+	/**
+	 * The drops of this region.
+	 */
+	UPROPERTY(Replicated)
+	FItemDropInstanceArray ItemDropInstances;
+
+	/**
+	 * Internal use only. Index in ItemDropInstances by drop id. Only maintained on the server.
+	 */
+	TMap<int, int> ItemDropInstanceIndexById;
+
+	/**
+	 * Internal use only. Instanced meshes by item.
+	 */
+	UPROPERTY(Transient)
+	TMap<FPrimaryAssetId, TObjectPtr<UInstancedStaticMeshComponent>> InstancedMeshes;
+
+	/**
+	 * Internal use only. Items whose instanced mesh has to be rebuilt.
+	 */
+	TSet<FPrimaryAssetId> DirtyAssets;
+
+	/**
+	 * Internal use only. Boolean indicating whether a rebuild is scheduled for the next tick.
+	 */
+	bool bIsRebuildScheduled = false;
+
+	virtual void BeginPlay() override;
+
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	/**
+	 * Internal use only. Check if this instance renders drops.
+	 *
+	 * @return False on dedicated servers.
+	 */
+	bool ShouldRender() const;
+
+	/**
+	 * Internal use only. Rebuild the instanced meshes of all dirty items.
+	 */
+	void RebuildInstancedMeshes();
+
+	/**
+	 * Internal use only. Request the visuals of all items of this region from UItemVisualsPreloadSubsystem.
+	 */
+	void RequestItemVisuals();
+
+	/**
+	 * Rebuild the instanced mesh of an item after its visuals were loaded.
+	 *
+	 * @param Asset The loaded item.
+	 */
+	UFUNCTION()
+	void HandleItemVisualsLoaded(const FPrimaryAssetId& Asset);
+
+public:
+	AItemDropRegion();
+
+	/**
+	 * Internal use only. Add a drop. Called by UItemDropSubsystem.
+	 *
+	 * @param ItemDropInstance The drop to add.
+	 */
+	void AddItemDropInstance(const FItemDropInstance& ItemDropInstance);
+
+	/**
+	 * Internal use only. Remove a drop. Called by UItemDropSubsystem.
+	 *
+	 * @param Id The id of the drop.
+	 * @param OutItemDropInstance The removed drop.
+	 * @return True if the drop was found.
+	 */
+	bool RemoveItemDropInstance(const int Id, FItemDropInstance& OutItemDropInstance);
+
+	/**
+	 * Internal use only. Find a drop. Only works on the server.
+	 *
+	 * @param Id The id of the drop.
+	 * @return The drop or nullptr if not found. Invalidated by adding or removing drops.
+	 */
+	const FItemDropInstance* FindItemDropInstance(const int Id) const;
+
+	/**
+	 * Get all drops of this region.
+	 *
+	 * @return The drops.
+	 */
+	const TArray<FItemDropInstance>& GetItemDropInstances() const;
+
+	/**
+	 * Internal use only. Schedule a rebuild of the instanced mesh of an item for the next tick.
+	 *
+	 * @param Asset The changed item.
+	 */
+	void MarkAssetDirty(const FPrimaryAssetId& Asset);
+};
+
+#undef LOCTEXT_NAMESPACE
@@ -0,0 +1,77 @@
+﻿// © 2024 Daniel Münch. All Rights Reserved
+
+#pragma once
+
+#include "ItemProperties.h"
+#include "ItemDropSpawnEntry.generated.h"
+
+#define LOCTEXT_NAMESPACE "InventorySystem"
+
+/**
+ * Pattern used to spread the drops of a batch around the spawn origin.
+ */
+UENUM(BlueprintType)
+enum class EItemDropScatterPattern : uint8
+{
+	// Spawn all drops at the origin.
+	Point,
+	// Spawn the drops evenly on a circle with the scatter radius.
+	Circle,
+	// Fill the scatter radius evenly from the center outwards.
+	Spiral,
+	// Spawn the drops at random points within the scatter radius.
+	Random
+};
+
+/**
+ * @struct FItemDropSpawnEntry
+ * @brief An item spawned by UItemDropSubsystem::SpawnItemDrops.
+ *
+ * Amounts above the stack size of the drop class are split into several drops. Items that can not stack are spawned once per amount.
+ *
+ * Example Use Case:
+ * @code
+ * TArray<FItemDropSpawnEntry> Loot;
+ * Loot.Add(FItemDropSpawnEntry(GoldAsset, 250));
+ * GetWorld()->GetSubsystem<UItemDropSubsystem>()->SpawnItemDrops(ItemDropClass, Loot, GetActorTransform(), EItemDropScatterPattern::Spiral, 300.f);
+ * @endcode
+ */
+USTRUCT(BlueprintType, Category = "Inventory System")
+struct INVENTORYSYSTEM_API FItemDropSpawnEntry
+{
+	GENERATED_BODY()
+
+	FItemDropSpawnEntry() {};
+
+	/**
+	 * Construct an FItemDropSpawnEntry with the specified values.
+	 *
+	 * @param InventoryAsset The item to spawn.
+	 * @param Amount The amount of the item.
+	 * @param DynamicStats The dynamic stats of the item.
+	 */
+	FItemDropSpawnEntry(const FPrimaryAssetId& InventoryAsset, const int Amount, const FItemProperties& DynamicStats = FItemProperties())
+		: InventoryAsset(InventoryAsset), Amount(Amount), DynamicStats(DynamicStats)
+	{
+	}
+
+	/**
+	 * The item to spawn.
+	 */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "Inventory System")
+	FPrimaryAssetId InventoryAsset;
+
+	/**
+	 * The amount of the item.
+	 */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "Inventory System", meta = (ClampMin="1"))
+	int Amount = 1;
+
+	/**
+	 * The dynamic stats of the item.
+	 */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "Inventory System")
+	FItemProperties DynamicStats;
+};
+
+#undef LOCTEXT_NAMESPACE
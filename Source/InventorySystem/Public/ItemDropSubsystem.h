@@ -0,0 +1,648 @@
+﻿// © 2024 Daniel Münch. All Rights Reserved
+
+#pragma once
+
+#include "ItemDropInstance.h"
+#include "ItemDropQuery.h"
+#include "ItemDropSpawnEntry.h"
+#include "ItemProperties.h"
+#include "Engine/TimerHandle.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "ItemDropSubsystem.generated.h"
+
+#define LOCTEXT_NAMESPACE "InventorySystem"
+
+class AItemDrop;
+class AItemDropRegion;
+
+/**
+ * @struct FItemDropPoolStatistics
+ * @brief Counters of the item drop pool of UItemDropSubsystem. Use them to size UInventorySystemSettings::ItemDropPoolSize.
+ */
+USTRUCT(BlueprintType, Category = "Inventory System")
+struct INVENTORYSYSTEM_API FItemDropPoolStatistics
+{
+	GENERATED_BODY()
+
+	/**
+	 * Idle drops currently kept in the pool.
+	 */
+	UPROPERTY(BlueprintReadOnly, Category = "Inventory System")
+	int PooledCount = 0;
+
+	/**
+	 * Highest number of idle drops kept in the pool at the same time.
+	 */
+	UPROPERTY(BlueprintReadOnly, Category = "Inventory System")
+	int PeakPooledCount = 0;
+
+	/**
+	 * Drops spawned because the pool had no idle drop of the requested class.
+	 */
+	UPROPERTY(BlueprintReadOnly, Category = "Inventory System")
+	int SpawnedCount = 0;
+
+	/**
+	 * Drops taken from the pool instead of spawning a new actor.
+	 */
+	UPROPERTY(BlueprintReadOnly, Category = "Inventory System")
+	int ReusedCount = 0;
+
+	/**
+	 * Drops returned to the pool.
+	 */
+	UPROPERTY(BlueprintReadOnly, Category = "Inventory System")
+	int ReleasedCount = 0;
+
+	/**
+	 * Drops destroyed on release because the pool was full or pooling is disabled.
+	 */
+	UPROPERTY(BlueprintReadOnly, Category = "Inventory System")
+	int DestroyedCount = 0;
+};
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FItemDropsSpawnedDelegate, int, BatchId, const TArray<AItemDrop*>&, ItemDrops);
+
+/**
+ * @class UItemDropSubsystem
+ * @brief Keeps track of all AItemDrop actors of a world in a uniform grid for fast proximity queries.
+ *
+ * Item drops register themselves on BeginPlay, update their grid cell when they move and unregister on EndPlay.
+ * Queries only visit the grid cells around the location instead of iterating all actors or running overlap queries.
+ * The cell size is configured with UInventorySystemSettings::ItemDropGridCellSize.
+ *
+ * The subsystem also pools item drops. Emptied drops are hidden, made dormant and reused by SpawnItemDrop instead of destroying
+ * and spawning actors and opening new actor channels. The pool size is configured with UInventorySystemSettings::ItemDropPoolSize.
+ *
+ * With UInventorySystemSettings::bMergeItemDrops enabled, new stackable drops are merged into nearby drops of the same item and dynamic stats
+ * once per frame, up to the stack size of the receiving drop.
+ *
+ * Spawned and lightweight drops despawn after UInventorySystemSettings::ItemDropLifetime or the lifetime of their item. Expiry is handled by
+ * a hierarchical timing wheel with one timer for all drops, so every tick only touches the drops expiring in it.
+ *
+ * SpawnItemDrops spawns loot of a whole kill as one batch. Items are validated once with cached asset data and the drops are spawned
+ * within UInventorySystemSettings::ItemDropSpawnBudget per frame.
+ *
+ * Loot that is rarely picked up can be added as lightweight drops. These are plain FItemDropInstance structs replicated in bulk by one
+ * AItemDropRegion per region and rendered with instanced static meshes. They are promoted to a real AItemDrop only on interaction.
+ *
+ * General Usage:
+ * - Use GetItemDropsInRadius to find all drops for auto loot or highlighting.
+ * - Use GetNearestItemDrops to find the closest drops for interaction prompts.
+ * - Use SpawnItemDrop on the server instead of SpawnActor to reuse pooled drops.
+ * - Use AddLightweightItemDrop on the server for large amounts of loot and UInventorySystemComponent::PickUpLightweightItemDrop to pick it up.
+ *
+ * Example Use Case:
+ * @code
+ * UItemDropSubsystem* ItemDropSubsystem = GetWorld()->GetSubsystem<UItemDropSubsystem>();
+ * TArray<AItemDrop*> ItemDrops = ItemDropSubsystem->GetItemDropsInRadius(PlayerLocation, 500.f, FItemDropQuery());
+ * @endcode
+ */
+UCLASS(Category = "Inventory System")
+class INVENTORYSYSTEM_API UItemDropSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+protected:
+	/**
+	 * Edge length of a grid cell.
+	 */
+	float CellSize = 1000.f;
+
+	/**
+	 * Internal use only. Registered drops by grid cell.
+	 */
+	TMap<FIntVector, TArray<TWeakObjectPtr<AItemDrop>>> ItemDropCells;
+
+	/**
+	 * Internal use only. Grid cell of every registered drop.
+	 */
+	TMap<TObjectKey<AItemDrop>, FIntVector> ItemDropCellByDrop;
+
+	/**
+	 * Internal use only. Get the grid cell of a location.
+	 *
+	 * @param Location The world location.
+	 * @return The grid cell.
+	 */
+	FIntVector GetCell(const FVector& Location) const;
+
+	/**
+	 * Internal use only. Remove a drop from a grid cell.
+	 *
+	 * @param ItemDrop The drop to remove.
+	 * @param Cell The grid cell of the drop.
+	 */
+	void RemoveFromCell(const AItemDrop* ItemDrop, const FIntVector& Cell);
+
+	/**
+	 * Internal use only. Check if a drop can be returned by a query.
+	 *
+	 * @param ItemDrop The drop to check.
+	 * @param Query The query filter.
+	 * @return True if the drop matches the query.
+	 */
+	static bool MatchesQuery(const AItemDrop* ItemDrop, const FItemDropQuery& Query);
+
+	/**
+	 * Maximum number of idle drops per class.
+	 */
+	int PoolSize = 64;
+
+	/**
+	 * Internal use only. Idle drops by class.
+	 */
+	TMap<TObjectKey<UClass>, TArray<TWeakObjectPtr<AItemDrop>>> PooledItemDrops;
+
+	/**
+	 * Internal use only. Counters of the pool.
+	 */
+	FItemDropPoolStatistics PoolStatistics;
+
+	/**
+	 * Internal use only. Take an idle drop of a class from the pool.
+	 *
+	 * @param ItemDropClass The class of the drop.
+	 * @return The drop or nullptr if none is pooled.
+	 */
+	AItemDrop* TakePooledItemDrop(const UClass* ItemDropClass);
+
+	/**
+	 * Internal use only. Boolean indicating whether new drops are merged automatically.
+	 */
+	bool bMergeItemDrops = false;
+
+	/**
+	 * Radius used for automatic merging.
+	 */
+	float MergeRadius = 200.f;
+
+	/**
+	 * Internal use only. Drops registered this frame waiting for the automatic merge.
+	 */
+	TArray<TWeakObjectPtr<AItemDrop>> PendingMergeItemDrops;
+
+	/**
+	 * Internal use only. Merge all drops registered this frame into their neighbours.
+	 */
+	void MergePendingItemDrops();
+
+	/**
+	 * Internal use only. Check if a drop can give or receive items in a merge.
+	 *
+	 * @param ItemDrop The drop to check.
+	 * @return True if the drop can be merged.
+	 */
+	static bool CanMerge(const AItemDrop* ItemDrop);
+
+	/**
+	 * Internal use only. A drop waiting in the despawn wheel. Either ItemDrop or LightweightId is set.
+	 */
+	struct FItemDropDespawnEntry
+	{
+		TWeakObjectPtr<AItemDrop> ItemDrop;
+		int LightweightId = INDEX_NONE;
+		uint64 ExpireTick = 0;
+	};
+
+	/**
+	 * Seconds per despawn wheel tick.
+	 */
+	static constexpr float DespawnTickInterval = 1.f;
+
+	/**
+	 * Number of slots of a despawn wheel level as bit count.
+	 */
+	static constexpr int DespawnWheelSlotBits = 6;
+
+	/**
+	 * Number of slots of a despawn wheel level.
+	 */
+	static constexpr int DespawnWheelSlots = 1 << DespawnWheelSlotBits;
+
+	/**
+	 * Number of despawn wheel levels. Each level covers DespawnWheelSlots times the range of the level below.
+	 */
+	static constexpr int DespawnWheelLevels = 4;
+
+	/**
+	 * Internal use only. Slots of all despawn wheel levels, level after level.
+	 */
+	TArray<TArray<FItemDropDespawnEntry>> DespawnWheel;
+
+	/**
+	 * Internal use only. Current despawn wheel tick.
+	 */
+	uint64 DespawnTick = 0;
+
+	/**
+	 * Internal use only. Scheduled expire tick by drop. Entries with a different tick are outdated, for example after pooling.
+	 */
+	TMap<TObjectKey<AItemDrop>, uint64> DespawnTickByDrop;
+
+	/**
+	 * Internal use only. Scheduled expire tick by lightweight drop.
+	 */
+	TMap<int, uint64> DespawnTickByLightweightId;
+
+	/**
+	 * Internal use only. Timer advancing the despawn wheel.
+	 */
+	FTimerHandle DespawnTimerHandle;
+
+	/**
+	 * Internal use only. Add an entry to the despawn wheel slot matching its expire tick.
+	 *
+	 * @param Entry The entry to add.
+	 */
+	void AddDespawnEntry(FItemDropDespawnEntry&& Entry);
+
+	/**
+	 * Internal use only. Advance the despawn wheel by one tick and despawn expired drops.
+	 */
+	void AdvanceDespawnWheel();
+
+	/**
+	 * Internal use only. Convert a lifetime into an expire tick and start the despawn timer.
+	 *
+	 * @param Lifetime The lifetime in seconds.
+	 * @return The expire tick.
+	 */
+	uint64 GetDespawnExpireTick(const float Lifetime);
+
+	/**
+	 * Internal use only. Cached asset data used to validate batched spawns.
+	 */
+	struct FItemDropAssetInfo
+	{
+		bool bIsValid = false;
+		bool bCanStack = false;
+	};
+
+	/**
+	 * Internal use only. A drop of a batch ready to spawn.
+	 */
+	struct FItemDropSpawnRequest
+	{
+		FItemDropSpawnEntry Entry;
+		bool bCanStack = false;
+		FTransform Transform;
+	};
+
+	/**
+	 * Internal use only. A batch of drops spawned over several frames.
+	 */
+	struct FItemDropSpawnBatch
+	{
+		int Id = INDEX_NONE;
+		TSubclassOf<AItemDrop> ItemDropClass;
+		TArray<FItemDropSpawnRequest> Requests;
+		int NextRequest = 0;
+		TArray<TWeakObjectPtr<AItemDrop>> ItemDrops;
+	};
+
+	/**
+	 * Internal use only. Cached asset data by item. Only valid lookups are cached.
+	 */
+	mutable TMap<FPrimaryAssetId, FItemDropAssetInfo> ItemDropAssetInfos;
+
+	/**
+	 * Internal use only. Batches waiting to be spawned, oldest first.
+	 */
+	TArray<FItemDropSpawnBatch> SpawnBatches;
+
+	/**
+	 * Internal use only. Id of the next batch.
+	 */
+	int NextSpawnBatchId = 0;
+
+	/**
+	 * Internal use only. Boolean indicating whether batches are spawned right now.
+	 */
+	bool bIsProcessingSpawnBatches = false;
+
+	/**
+	 * Internal use only. Seconds per frame spent on batches.
+	 */
+	double SpawnBudget = 0.001;
+
+	/**
+	 * Internal use only. Get the cached asset data of an item. Returned by value as later lookups can grow the cache.
+	 *
+	 * @param InventoryAsset The item.
+	 * @return The cached asset data.
+	 */
+	FItemDropAssetInfo GetItemDropAssetInfo(const FPrimaryAssetId& InventoryAsset) const;
+
+	/**
+	 * Internal use only. Spawn or reuse a drop.
+	 *
+	 * @param ItemDropClass		The class of the drop.
+	 * @param InventoryAsset	The item of the drop.
+	 * @param Amount			The amount of the item.
+	 * @param DynamicStats		The dynamic stats of the item.
+	 * @param Transform			The transform of the drop.
+	 * @param bIsValidated		Skip the checks of the drop because the item data was validated in advance.
+	 * @param bCanStack			Cached stackability, only used if validated.
+	 * @return The drop or nullptr if the drop could not be set up.
+	 */
+	AItemDrop* SpawnItemDropInternal(const TSubclassOf<AItemDrop>& ItemDropClass, const FPrimaryAssetId& InventoryAsset, const int Amount, const FItemProperties& DynamicStats, const FTransform& Transform, const bool bIsValidated, const bool bCanStack);
+
+	/**
+	 * Internal use only. Spawn pending batches until the frame budget is used up.
+	 */
+	void ProcessSpawnBatches();
+
+	/**
+	 * Internal use only. Get the scattered location of a drop of a batch relative to the origin.
+	 *
+	 * @param Pattern The scatter pattern.
+	 * @param Index The index of the drop in the batch.
+	 * @param Count The number of drops in the batch.
+	 * @param Radius The scatter radius.
+	 * @return The offset from the origin.
+	 */
+	static FVector GetScatterOffset(const EItemDropScatterPattern Pattern, const int Index, const int Count, const float Radius);
+
+	/**
+	 * Edge length of a lightweight drop region.
+	 */
+	float RegionSize = 10000.f;
+
+	/**
+	 * Internal use only. Lightweight drop regions by region cell. Filled on the server and on clients.
+	 */
+	TMap<FIntVector, TWeakObjectPtr<AItemDropRegion>> ItemDropRegions;
+
+	/**
+	 * Internal use only. Region cell of every lightweight drop. Only maintained on the server.
+	 */
+	TMap<int, FIntVector> ItemDropRegionById;
+
+	/**
+	 * Internal use only. Id of the next lightweight drop.
+	 */
+	int NextItemDropInstanceId = 0;
+
+	/**
+	 * Internal use only. Get the region cell of a location.
+	 *
+	 * @param Location The world location.
+	 * @return The region cell.
+	 */
+	FIntVector GetRegion(const FVector& Location) const;
+
+	/**
+	 * Internal use only. Check if a lightweight drop can be returned by a query.
+	 *
+	 * @param ItemDropInstance The drop to check.
+	 * @param Query The query filter.
+	 * @return True if the drop matches the query.
+	 */
+	bool MatchesQuery(const FItemDropInstance& ItemDropInstance, const FItemDropQuery& Query) const;
+
+public:
+	/**
+	 * Delegate to add functionality after all drops of a batch were spawned.
+	 */
+	UPROPERTY(BlueprintAssignable, BlueprintCallable)
+	FItemDropsSpawnedDelegate ItemDropsSpawnedDelegate;
+
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+	virtual void Deinitialize() override;
+
+	/**
+	 * Internal use only. Add a drop to the grid. Called by AItemDrop::BeginPlay.
+	 *
+	 * @param ItemDrop The drop to add.
+	 */
+	void RegisterItemDrop(AItemDrop* ItemDrop);
+
+	/**
+	 * Internal use only. Remove a drop from the grid. Called by AItemDrop::EndPlay.
+	 *
+	 * @param ItemDrop The drop to remove.
+	 */
+	void UnregisterItemDrop(const AItemDrop* ItemDrop);
+
+	/**
+	 * Internal use only. Move a drop to the grid cell of its current location. Called when the root component of the drop moved.
+	 *
+	 * @param ItemDrop The moved drop.
+	 */
+	void UpdateItemDrop(AItemDrop* ItemDrop);
+
+	/**
+	 * Get all drops within a radius.
+	 *
+	 * @param Location The center of the search.
+	 * @param Radius The search radius.
+	 * @param Query Filter for asset and stackability.
+	 * @return The drops in no particular order.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Inventory System")
+	TArray<AItemDrop*> GetItemDropsInRadius(const FVector& Location, const float Radius, const FItemDropQuery& Query) const;
+
+	/**
+	 * Get the nearest drops around a location. Only grid cells that can contain closer drops than the already found ones are visited.
+	 *
+	 * @param Location The center of the search.
+	 * @param Count Maximum number of drops to return.
+	 * @param MaxRadius Maximum distance of returned drops.
+	 * @param Query Filter for asset and stackability.
+	 * @return The drops ordered by distance, nearest first.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Inventory System")
+	TArray<AItemDrop*> GetNearestItemDrops(const FVector& Location, const int Count, const float MaxRadius, const FItemDropQuery& Query) const;
+
+	/**
+	 * Get the number of registered drops.
+	 * @return The number of drops in the grid.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Inventory System")
+	int GetRegisteredItemDropCount() const;
+
+	/**
+	 * Server only. Spawn a drop or reuse an idle drop of the same class from the pool.
+	 *
+	 * @param ItemDropClass		The class of the drop.
+	 * @param InventoryAsset	The item of the drop.
+	 * @param Amount			The amount of the item.
+	 * @param DynamicStats		The dynamic stats of the item.
+	 * @param Transform			The transform of the drop.
+	 * @return The drop or nullptr if the drop could not be set up.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Inventory System")
+	AItemDrop* SpawnItemDrop(TSubclassOf<AItemDrop> ItemDropClass, const FPrimaryAssetId& InventoryAsset, const int Amount, const FItemProperties& DynamicStats, const FTransform& Transform);
+
+	/**
+	 * Server only. Return a drop to the pool. The drop is destroyed if the pool of its class is full.
+	 * Called by AItemDrop::AfterPickUpEvent for emptied drops.
+	 *
+	 * @param ItemDrop The drop to release.
+	 * @return True if the drop was pooled, false if it was destroyed.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Inventory System")
+	bool ReleaseItemDrop(AItemDrop* ItemDrop);
+
+	/**
+	 * Server only. Spawn the loot of a kill or chest as one batch. All items are validated once, amounts are split by the stack size of the
+	 * drop class and the drops are spread with the scatter pattern. Drops are spawned within the frame budget, the rest in the next frames.
+	 *
+	 * @param ItemDropClass	The class of the drops.
+	 * @param Entries		The items to spawn.
+	 * @param Origin		The center and orientation of the scatter pattern.
+	 * @param Pattern		The scatter pattern.
+	 * @param ScatterRadius	The radius of the scatter pattern.
+	 * @return The id of the batch passed to ItemDropsSpawnedDelegate or INDEX_NONE if nothing is spawned.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Inventory System")
+	int SpawnItemDrops(TSubclassOf<AItemDrop> ItemDropClass, const TArray<FItemDropSpawnEntry>& Entries, const FTransform& Origin, const EItemDropScatterPattern Pattern = EItemDropScatterPattern::Spiral, const float ScatterRadius = 200.f);
+
+	/**
+	 * Get the counters of the pool.
+	 *
+	 * @return The pool statistics.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Inventory System")
+	FItemDropPoolStatistics GetPoolStatistics() const;
+
+	/**
+	 * Server only. Move the amount of a drop into nearby drops of the same class, item and dynamic stats until they are full.
+	 * The drop is returned to the pool if it was emptied.
+	 *
+	 * @param ItemDrop The drop to merge.
+	 * @param Radius The search radius around the drop.
+	 * @return True if the drop was emptied.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Inventory System")
+	bool MergeItemDrop(AItemDrop* ItemDrop, const float Radius);
+
+	/**
+	 * Server only. Merge all drops within a radius, for example after a large fight.
+	 *
+	 * @param Location The center of the merge.
+	 * @param Radius The radius of drops to merge.
+	 * @param ItemDropMergeRadius The radius around every drop other drops are merged into.
+	 * @return The number of emptied drops.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Inventory System")
+	int MergeItemDropsInRadius(const FVector& Location, const float Radius, const float ItemDropMergeRadius);
+
+	/**
+	 * Internal use only. Add a region to the lookup. Called by AItemDropRegion::BeginPlay.
+	 *
+	 * @param ItemDropRegion The region to add.
+	 */
+	void RegisterItemDropRegion(AItemDropRegion* ItemDropRegion);
+
+	/**
+	 * Internal use only. Remove a region from the lookup. Called by AItemDropRegion::EndPlay.
+	 *
+	 * @param ItemDropRegion The region to remove.
+	 */
+	void UnregisterItemDropRegion(const AItemDropRegion* ItemDropRegion);
+
+	/**
+	 * Server only. Add a lightweight drop without spawning an actor. Amounts above the stack size of UInventorySystemSettings::LightweightItemDropClass
+	 * are split into several drops at the same transform, so every drop can be promoted without losing items. Items that can not stack are added once per amount.
+	 *
+	 * @param InventoryAsset	The item of the drop.
+	 * @param Amount			The amount of the item.
+	 * @param DynamicStats		The dynamic stats of the item.
+	 * @param Transform			The transform of the drop.
+	 * @return The id of the first drop or INDEX_NONE if the drop is invalid.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Inventory System")
+	int AddLightweightItemDrop(const FPrimaryAssetId& InventoryAsset, const int Amount, const FItemProperties& DynamicStats, const FTransform& Transform);
+
+	/**
+	 * Server only. Remove a lightweight drop.
+	 *
+	 * @param Id The id of the drop.
+	 * @param OutItemDropInstance The removed drop.
+	 * @return True if the drop was found.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Inventory System")
+	bool RemoveLightweightItemDrop(const int Id, FItemDropInstance& OutItemDropInstance);
+
+	/**
+	 * Server only. Find a lightweight drop by id.
+	 *
+	 * @param Id The id of the drop.
+	 * @param OutItemDropInstance The found drop.
+	 * @return True if the drop was found.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Inventory System")
+	bool FindLightweightItemDrop(const int Id, FItemDropInstance& OutItemDropInstance) const;
+
+	/**
+	 * Server only. Replace a lightweight drop with an AItemDrop of UInventorySystemSettings::LightweightItemDropClass.
+	 * The drop keeps its amount. The lightweight drop is only removed if the spawn succeeded.
+	 *
+	 * @param Id The id of the drop.
+	 * @return The spawned or reused drop or nullptr if the lightweight drop does not exist or the spawn failed.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Inventory System")
+	AItemDrop* PromoteLightweightItemDrop(const int Id);
+
+	/**
+	 * Get all lightweight drops within a radius. Works on clients for all drops of replicated regions.
+	 *
+	 * @param Location The center of the search.
+	 * @param Radius The search radius.
+	 * @param Query Filter for asset and stackability.
+	 * @return The drops in no particular order.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Inventory System")
+	TArray<FItemDropInstance> GetLightweightItemDropsInRadius(const FVector& Location, const float Radius, const FItemDropQuery& Query) const;
+
+	/**
+	 * Server only. Get the number of lightweight drops.
+	 *
+	 * @return The number of lightweight drops.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Inventory System")
+	int GetLightweightItemDropCount() const;
+
+	/**
+	 * Get the configured lifetime of drops of an item.
+	 *
+	 * @param InventoryAsset The item.
+	 * @return The lifetime in seconds or 0 if drops of the item do not despawn.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Inventory System")
+	static float GetItemDropLifetime(const FPrimaryAssetId& InventoryAsset);
+
+	/**
+	 * Server only. Replace the despawn time of a drop. Spawned drops are scheduled automatically with their item lifetime.
+	 *
+	 * @param ItemDrop The drop.
+	 * @param Lifetime Seconds from now until the drop despawns. 0 keeps the drop forever.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Inventory System")
+	void ScheduleItemDropDespawn(AItemDrop* ItemDrop, const float Lifetime);
+
+	/**
+	 * Server only. Replace the despawn time of a lightweight drop. Lightweight drops are scheduled automatically with their item lifetime.
+	 *
+	 * @param Id The id of the lightweight drop.
+	 * @param Lifetime Seconds from now until the drop despawns. 0 keeps the drop forever.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Inventory System")
+	void ScheduleLightweightItemDropDespawn(const int Id, const float Lifetime);
+
+	/**
+	 * Get the number of drops and lightweight drops scheduled to despawn.
+	 *
+	 * @return The number of scheduled drops.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Inventory System")
+	int GetScheduledDespawnCount() const;
+};
+
+#undef LOCTEXT_NAMESPACE
@@ -4,6 +4,7 @@
 
 #include "ItemEquipmentTypeDataAsset.h"
 #include "ItemDataAsset.h"
+#include "ItemProperties.h"
 #include "ItemEquipmentDataAsset.generated.h"
 
 #define LOCTEXT_NAMESPACE "InventorySystem"
@@ -55,6 +56,12 @@ public:
 	UPROPERTY(BlueprintReadOnly, Category = "Inventory System|Types", AssetRegistrySearchable, meta = (EditCondition = "false", AllowedClasses = "/Script/InventorySystem.ItemEquipmentTypeDataAsset", ExactClass = false))
 	TArray<FPrimaryAssetId> EquipmentType;
 
+	/**
+	 * Base stats of this equipment. Numeric values are added to the equipment stat totals of UInventorySystemComponent while equipped.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Inventory System|Stats", AssetRegistrySearchable)
+	FItemProperties BaseStats;
+
 	/**
 	 * Implement Interface.
 	 * 
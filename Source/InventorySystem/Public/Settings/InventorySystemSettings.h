@@ -7,6 +7,8 @@
 
 #define LOCTEXT_NAMESPACE "InventorySystem"
 
+class AItemDrop;
+
 /**
  * @class UInventorySystemSettings
  * @brief Configuration settings for the Inventory System, defining global parameters like maximum stack sizes and inventory dimensions.
@@ -56,6 +58,12 @@ public:
 	UPROPERTY(Config, EditDefaultsOnly, Category = "Inventory", meta = (ClampMin="2", EditCondition = "bHasBegunPlayEditor == 0"))
 	int MaxItemEquipmentStackSize;
 
+	/**
+	 * Highest equipment slot number UInventorySystemComponent::SetEquipmentType accepts. Requests for larger or negative slots are rejected on the server.
+	 */
+	UPROPERTY(Config, EditDefaultsOnly, Category = "Inventory", meta = (ClampMin="0", EditCondition = "bHasBegunPlayEditor == 0"))
+	int MaxEquipmentSlot;
+
 	/**
 	 * The global maximum stack size for items.
 	 */
@@ -74,6 +82,78 @@ public:
 	UPROPERTY(Config, EditDefaultsOnly, Category = "Item Drop", meta = (ClampMin="2", EditCondition = "bHasBegunPlayEditor == 0"))
 	int MaxItemDropStackSize;
 
+	/**
+	 * Edge length of the grid cells UItemDropSubsystem sorts item drops into. Should be close to the usual pick up or search radius.
+	 */
+	UPROPERTY(Config, EditDefaultsOnly, Category = "Item Drop", meta = (ClampMin="100", EditCondition = "bHasBegunPlayEditor == 0"))
+	float ItemDropGridCellSize;
+
+	/**
+	 * Maximum number of idle item drops UItemDropSubsystem keeps per item drop class for reuse. 0 disables pooling.
+	 */
+	UPROPERTY(Config, EditDefaultsOnly, Category = "Item Drop", meta = (ClampMin="0", EditCondition = "bHasBegunPlayEditor == 0"))
+	int ItemDropPoolSize;
+
+	/**
+	 * Merge newly spawned stackable item drops into nearby drops of the same item and dynamic stats.
+	 */
+	UPROPERTY(Config, EditDefaultsOnly, Category = "Item Drop", meta = (EditCondition = "bHasBegunPlayEditor == 0"))
+	bool bMergeItemDrops;
+
+	/**
+	 * Radius in which item drops are merged.
+	 */
+	UPROPERTY(Config, EditDefaultsOnly, Category = "Item Drop", meta = (ClampMin="0", EditCondition = "bHasBegunPlayEditor == 0 && bMergeItemDrops"))
+	float ItemDropMergeRadius;
+
+	/**
+	 * Largest radius UInventorySystemComponent::PickUpItemDropsInRadius accepts. Larger radii requested by clients are clamped on the server.
+	 */
+	UPROPERTY(Config, EditDefaultsOnly, Category = "Item Drop", meta = (ClampMin="0", EditCondition = "bHasBegunPlayEditor == 0"))
+	float MaxItemDropPickUpRadius;
+
+	/**
+	 * Seconds after which spawned item drops and lightweight item drops despawn. 0 keeps drops forever. Placed drops never despawn.
+	 */
+	UPROPERTY(Config, EditDefaultsOnly, Category = "Item Drop", meta = (ClampMin="0", EditCondition = "bHasBegunPlayEditor == 0"))
+	float ItemDropLifetime;
+
+	/**
+	 * Despawn time in seconds per item. Overrides ItemDropLifetime. 0 keeps drops of the item forever.
+	 */
+	UPROPERTY(Config, EditDefaultsOnly, Category = "Item Drop", meta = (EditCondition = "bHasBegunPlayEditor == 0"))
+	TMap<FPrimaryAssetId, float> ItemDropLifetimes;
+
+	/**
+	 * Milliseconds per frame UItemDropSubsystem::SpawnItemDrops may spend spawning drops. Remaining drops are spawned in the next frames.
+	 */
+	UPROPERTY(Config, EditDefaultsOnly, Category = "Item Drop", meta = (ClampMin="0.1", EditCondition = "bHasBegunPlayEditor == 0"))
+	float ItemDropSpawnBudget;
+
+	/**
+	 * Edge length of the regions lightweight item drops are replicated in. Each region is one actor channel.
+	 */
+	UPROPERTY(Config, EditDefaultsOnly, Category = "Item Drop", meta = (ClampMin="1000", EditCondition = "bHasBegunPlayEditor == 0"))
+	float LightweightItemDropRegionSize;
+
+	/**
+	 * Distance up to which clients receive and render the lightweight item drops of a region.
+	 */
+	UPROPERTY(Config, EditDefaultsOnly, Category = "Item Drop", meta = (ClampMin="1000", EditCondition = "bHasBegunPlayEditor == 0"))
+	float LightweightItemDropNetCullDistance;
+
+	/**
+	 * Item drop class lightweight item drops are promoted to when a player interacts with them.
+	 */
+	UPROPERTY(Config, EditDefaultsOnly, Category = "Item Drop", meta = (EditCondition = "bHasBegunPlayEditor == 0"))
+	TSoftClassPtr<AItemDrop> LightweightItemDropClass;
+
+	/**
+	 * Numeric item property names that item containers keep in a sorted index. Enables fast range and top-k queries for these properties.
+	 */
+	UPROPERTY(Config, EditDefaultsOnly, Category = "Query")
+	TArray<FName> IndexedPropertyNames;
+
 #if WITH_EDITORONLY_DATA
 	/**
 	 * Propagate changes to components and actors.
@@ -0,0 +1,60 @@
+﻿// © 2024 Daniel Münch. All Rights Reserved
+
+#pragma once
+
+#include "InventorySlots.h"
+#include "InventorySlotListItem.generated.h"
+
+#define LOCTEXT_NAMESPACE "InventorySystem"
+
+class UItemContainerComponent;
+
+/**
+ * @class UInventorySlotListItem
+ * @brief Lightweight list item of an inventory slot used by UUI_InventoryTileView.
+ *
+ * The item only stores the component and slot. Entry widgets read the slot data on demand, so
+ * list items stay valid when the slot content changes.
+ */
+UCLASS(BlueprintType, Category = "Inventory System")
+class INVENTORYSYSTEM_API UInventorySlotListItem : public UObject
+{
+    GENERATED_BODY()
+
+protected:
+    /**
+     * Component the inventory slot belongs to.
+     */
+    TWeakObjectPtr<UItemContainerComponent> ItemContainerComponent;
+
+public:
+    /**
+     * Inventory slot represented by this item.
+     */
+    UPROPERTY(BlueprintReadOnly, Category = "Inventory System")
+    int InventorySlot = INDEX_NONE;
+
+    /**
+     * Set the component and inventory slot represented by this item.
+     *
+     * @param NewItemContainerComponent The component of the slot.
+     * @param NewInventorySlot The inventory slot.
+     */
+    void SetInventorySlot(UItemContainerComponent* NewItemContainerComponent, const int NewInventorySlot);
+
+    /**
+     * Get the component the inventory slot belongs to.
+     * @return The component or nullptr if it was destroyed.
+     */
+    UFUNCTION(BlueprintCallable, Category = "Inventory System")
+    UItemContainerComponent* GetItemContainerComponent() const;
+
+    /**
+     * Retrieves the current data of the inventory slot.
+     * @return The inventory slot or an empty slot if the component is invalid.
+     */
+    UFUNCTION(BlueprintCallable, Category = "Inventory System")
+    FInventorySlot GetInventorySlotData() const;
+};
+
+#undef LOCTEXT_NAMESPACE
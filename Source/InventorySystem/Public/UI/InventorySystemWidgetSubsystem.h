@@ -0,0 +1,139 @@
+﻿// © 2024 Daniel Münch. All Rights Reserved
+
+#pragma once
+
+#include "Subsystems/LocalPlayerSubsystem.h"
+#include "InventorySystemWidgetSubsystem.generated.h"
+
+#define LOCTEXT_NAMESPACE "InventorySystem"
+
+class APawn;
+class APlayerController;
+class APlayerState;
+class UInventorySystemComponent;
+class UItemContainerComponent;
+
+// C++ only delegate called when the resolved player components changed. Widgets use it to move their slot subscriptions.
+DECLARE_MULTICAST_DELEGATE(FResolvedPlayerComponentsChangedDelegate);
+
+/**
+ * @class UInventorySystemWidgetSubsystem
+ * @brief Resolves the inventory components of a local player once and shares the result with all of its slot widgets.
+ *
+ * The components are looked up on the PlayerState of the player controller and kept as weak pointers.
+ * The lookup is repeated only if the PlayerState or the possessed pawn of the player controller changed.
+ * Components that finish their setup later are picked up through UItemContainerComponent::ItemContainerComponentReadyDelegate,
+ * so widgets only listen to ResolvedPlayerComponentsChangedDelegate instead of waiting for the component themselves.
+ *
+ * General Usage:
+ * - UUI_InventoryItem, UUI_EquipmentItem and UUI_InventoryTileView use this subsystem if no custom component is set.
+ *
+ * Example Use Case:
+ * @code
+ * if (UInventorySystemWidgetSubsystem* Subsystem = UInventorySystemWidgetSubsystem::Get(PlayerController))
+ * {
+ *     UInventorySystemComponent* InventorySystemComponent = Subsystem->GetInventorySystemComponent(PlayerController);
+ * }
+ * @endcode
+ */
+UCLASS(Category = "Inventory System")
+class INVENTORYSYSTEM_API UInventorySystemWidgetSubsystem : public ULocalPlayerSubsystem
+{
+	GENERATED_BODY()
+
+protected:
+	/**
+	 * PlayerState the components were resolved from.
+	 */
+	TWeakObjectPtr<APlayerState> CachedPlayerState;
+
+	/**
+	 * Pawn possessed while the components were resolved.
+	 */
+	TWeakObjectPtr<APawn> CachedPawn;
+
+	/**
+	 * Resolved item container component of the PlayerState.
+	 */
+	TWeakObjectPtr<UItemContainerComponent> CachedItemContainerComponent;
+
+	/**
+	 * Resolved inventory system component of the PlayerState.
+	 */
+	TWeakObjectPtr<UInventorySystemComponent> CachedInventorySystemComponent;
+
+	/**
+	 * True if the cached values belong to a finished lookup, even if no component was found.
+	 */
+	bool bIsResolved = false;
+
+	/**
+	 * Handle of the subscription to UItemContainerComponent::ItemContainerComponentReadyDelegate.
+	 */
+	FDelegateHandle ComponentReadyHandle;
+
+	/**
+	 * Internal use only. Resolve the components again if the PlayerState or pawn of the player controller changed.
+	 *
+	 * @param PlayerController The player controller owning the widgets.
+	 */
+	void UpdateResolvedComponents(const APlayerController* PlayerController);
+
+	/**
+	 * Internal use only. Resolve the components of a PlayerState and broadcast if they changed.
+	 *
+	 * @param PlayerState The PlayerState to resolve the components from.
+	 * @param Pawn The pawn possessed by the player controller.
+	 */
+	void ResolveComponents(APlayerState* PlayerState, APawn* Pawn);
+
+	/**
+	 * Accept a component that finished its setup if it belongs to the PlayerState of the local player.
+	 * The PlayerState can finish its setup before the player controller points to it.
+	 *
+	 * @param Component The component that finished its setup.
+	 */
+	void HandleComponentReady(UItemContainerComponent* Component);
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+	virtual void Deinitialize() override;
+
+	/**
+	 * Called after the resolved components changed, including the first time they became available.
+	 */
+	FResolvedPlayerComponentsChangedDelegate ResolvedPlayerComponentsChangedDelegate;
+
+	/**
+	 * Get the subsystem of the local player owning the player controller.
+	 *
+	 * @param PlayerController The player controller of a local player.
+	 * @return The subsystem or nullptr if the player controller has no local player.
+	 */
+	static UInventorySystemWidgetSubsystem* Get(const APlayerController* PlayerController);
+
+	/**
+	 * Get the item container component of the PlayerState.
+	 *
+	 * @param PlayerController The player controller owning the widget.
+	 * @return The cached component or nullptr.
+	 */
+	UItemContainerComponent* GetItemContainerComponent(const APlayerController* PlayerController);
+
+	/**
+	 * Get the inventory system component of the PlayerState.
+	 *
+	 * @param PlayerController The player controller owning the widget.
+	 * @return The cached component or nullptr.
+	 */
+	UInventorySystemComponent* GetInventorySystemComponent(const APlayerController* PlayerController);
+
+	/**
+	 * Drop the cached components. The next request resolves them again.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Inventory System")
+	void InvalidateResolvedComponents();
+};
+
+#undef LOCTEXT_NAMESPACE
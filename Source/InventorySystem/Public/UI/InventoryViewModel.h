@@ -0,0 +1,202 @@
+﻿// © 2024 Daniel Münch. All Rights Reserved
+
+#pragma once
+
+#include "ItemContainerComponent.h"
+#include "InventoryViewModel.generated.h"
+
+#define LOCTEXT_NAMESPACE "InventorySystem"
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FInventoryViewRowsChangedDelegate, const int, FirstRow, const int, LastRow);
+
+/**
+ * @class UInventoryViewModel
+ * @brief Filtered and sorted projection of the inventory slots of an item container component.
+ *
+ * The view model keeps one row per visible, non empty inventory slot. Changed slots reported by
+ * UItemContainerComponent::ChangedInventorySlotsDelegate are removed, inserted or repositioned on their own,
+ * so rows of unchanged slots keep their index unless a changed row moved across them.
+ * The order is the same as UItemContainerComponent::SortItems.
+ *
+ * General Usage:
+ * - Create the view model, set sort and filter, then bind it to a component.
+ * - Read rows with GetRowCount and GetRowSlot. Refresh the rows reported by InventoryViewRowsChangedDelegate.
+ *
+ * Example Use Case:
+ * @code
+ * UInventoryViewModel* ViewModel = NewObject<UInventoryViewModel>(this);
+ * ViewModel->SetSort(EItemContainerSortKey::Amount, NAME_None, true);
+ * ViewModel->SetFilterText(TEXT("Potion"));
+ * ViewModel->SetItemContainerComponent(Inventory);
+ * @endcode
+ */
+UCLASS(BlueprintType, Category = "Inventory System")
+class INVENTORYSYSTEM_API UInventoryViewModel : public UObject
+{
+	GENERATED_BODY()
+
+protected:
+	/**
+	 * Internal use only. Precomputed sort key of a row, so comparisons do not convert texts.
+	 */
+	struct FInventoryViewRowKey
+	{
+		int Slot = INDEX_NONE;
+		FString AssetName;
+		int Amount = 0;
+		bool bHasProperty = false;
+		bool bIsNumeric = false;
+		double NumericValue = 0.0;
+		FString TextValue;
+	};
+
+	/**
+	 * Component the rows are projected from.
+	 */
+	TWeakObjectPtr<UItemContainerComponent> ItemContainerComponent;
+
+	/**
+	 * Inventory slots in row order.
+	 */
+	TArray<int> Rows;
+
+	/**
+	 * Internal use only. Sort keys of all slots that have a row.
+	 */
+	TMap<int, FInventoryViewRowKey> RowKeys;
+
+	/**
+	 * Key used to order the rows.
+	 */
+	EItemContainerSortKey SortKey = EItemContainerSortKey::Asset;
+
+	/**
+	 * Dynamic item property used when SortKey is PropertyValue.
+	 */
+	FName SortPropertyName;
+
+	/**
+	 * Order rows descending.
+	 */
+	bool bSortDescending = false;
+
+	/**
+	 * Only slots whose asset name contains this text have a row. Ignored if empty.
+	 */
+	FString FilterText;
+
+	/**
+	 * Internal use only. Build the sort key of an inventory slot.
+	 *
+	 * @param InventorySlot The inventory slot.
+	 * @return The sort key.
+	 */
+	FInventoryViewRowKey MakeRowKey(const FInventorySlot& InventorySlot) const;
+
+	/**
+	 * Internal use only. Check if an inventory slot passes the filter.
+	 *
+	 * @param InventorySlot The inventory slot.
+	 * @return True if the slot should have a row.
+	 */
+	bool PassesFilter(const FInventorySlot& InventorySlot) const;
+
+	/**
+	 * Internal use only. Strict weak order of two rows.
+	 *
+	 * @param First The first row key.
+	 * @param Second The second row key.
+	 * @return True if First is placed before Second.
+	 */
+	bool IsRowBefore(const FInventoryViewRowKey& First, const FInventoryViewRowKey& Second) const;
+
+	/**
+	 * Internal use only. Find the row index of a slot by binary search over its stored key.
+	 *
+	 * @param Slot The inventory slot.
+	 * @return The row index or INDEX_NONE.
+	 */
+	int FindRow(const int Slot) const;
+
+	/**
+	 * Rebuild all rows from the component. Used after binding or when sort or filter changed.
+	 */
+	void RebuildRows();
+
+	/**
+	 * Remove, insert or reposition the rows of changed slots.
+	 *
+	 * @param Slots The changed inventory slots.
+	 */
+	UFUNCTION()
+	void HandleChangedInventorySlots(const TArray<int>& Slots);
+
+public:
+	/**
+	 * Delegate used to add functionality after rows changed. All rows from FirstRow to LastRow must be refreshed.
+	 */
+	UPROPERTY(BlueprintAssignable, BlueprintCallable)
+	FInventoryViewRowsChangedDelegate InventoryViewRowsChangedDelegate;
+
+	virtual void BeginDestroy() override;
+
+	/**
+	 * Set the component to project. Rebuilds all rows.
+	 *
+	 * @param NewItemContainerComponent The component or nullptr to clear the rows.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Inventory System")
+	void SetItemContainerComponent(UItemContainerComponent* NewItemContainerComponent);
+
+	/**
+	 * Set the order of the rows. Rebuilds all rows.
+	 *
+	 * @param NewSortKey		The key used to order the rows.
+	 * @param PropertyName		The dynamic item property used when SortKey is PropertyValue, for example Rarity.
+	 * @param bDescending		Order rows descending.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Inventory System")
+	void SetSort(const EItemContainerSortKey NewSortKey, const FName PropertyName = NAME_None, const bool bDescending = false);
+
+	/**
+	 * Set the text filter. Rebuilds all rows.
+	 *
+	 * @param NewFilterText Only slots whose asset name contains this text are shown. Empty shows all slots.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Inventory System")
+	void SetFilterText(const FString& NewFilterText);
+
+	/**
+	 * Get the number of rows.
+	 * @return The number of rows.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Inventory System")
+	int GetRowCount() const;
+
+	/**
+	 * Get the inventory slot shown in a row.
+	 *
+	 * @param Row The row index.
+	 * @return The inventory slot or INDEX_NONE.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Inventory System")
+	int GetRowSlot(const int Row) const;
+
+	/**
+	 * Get the row of an inventory slot.
+	 *
+	 * @param Slot The inventory slot.
+	 * @return The row index or INDEX_NONE if the slot is empty or filtered.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Inventory System")
+	int GetSlotRow(const int Slot) const;
+
+	/**
+	 * Get all inventory slots in row order.
+	 * @return The inventory slots.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Inventory System")
+	TArray<int> GetRows() const;
+};
+
+#undef LOCTEXT_NAMESPACE
@@ -0,0 +1,160 @@
+﻿// © 2024 Daniel Münch. All Rights Reserved
+
+#pragma once
+
+#include "Engine/StreamableManager.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "ItemVisualsPreloadSubsystem.generated.h"
+
+#define LOCTEXT_NAMESPACE "InventorySystem"
+
+class UItemContainerComponent;
+
+/**
+ * Load state of the "Visuals" asset bundle of an item.
+ */
+UENUM(BlueprintType)
+enum class EItemVisualsLoadState : uint8
+{
+	// No preload was requested.
+	NotRequested,
+	// The bundle is loading asynchronously.
+	Loading,
+	// The bundle is loaded and kept in memory while requested.
+	Loaded
+};
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FItemVisualsLoadedDelegate, const FPrimaryAssetId&, Asset);
+
+/**
+ * @class UItemVisualsPreloadSubsystem
+ * @brief Loads the "Visuals" asset bundle of items asynchronously before widgets need them.
+ *
+ * Requesters, for example an inventory page, pass the assets of their visible and adjacent slots. Visible assets are loaded with high priority,
+ * adjacent assets with default priority. Assets no longer requested by anyone are cancelled while loading or released once loaded.
+ * The bundle is loaded through the streamable manager with handles owned by this subsystem, so bundle states set through the asset manager are not changed.
+ *
+ * General Usage:
+ * - Call PreloadInventorySlots when a page opens, scrolls or its slots replicated.
+ * - Call ReleaseItemVisuals when the page closes.
+ * - Use GetItemVisualsLoadState and ItemVisualsLoadedDelegate to show a placeholder until the icon is loaded.
+ *
+ * Example Use Case:
+ * @code
+ * UItemVisualsPreloadSubsystem* Subsystem = UItemVisualsPreloadSubsystem::Get(this);
+ * Subsystem->PreloadInventorySlots(this, Inventory, 1, 40, 40);
+ * @endcode
+ */
+UCLASS(Category = "Inventory System")
+class INVENTORYSYSTEM_API UItemVisualsPreloadSubsystem : public UGameInstanceSubsystem
+{
+	GENERATED_BODY()
+
+protected:
+	/**
+	 * Internal use only. Streamable handle of an asset and the number of requesters using it.
+	 */
+	struct FItemVisualsRequest
+	{
+		TSharedPtr<FStreamableHandle> Handle;
+		TAsyncLoadPriority Priority = FStreamableManager::DefaultAsyncLoadPriority;
+		int RequesterCount = 0;
+		bool bIsLoaded = false;
+	};
+
+	/**
+	 * Internal use only. Requests by asset.
+	 */
+	TMap<FPrimaryAssetId, FItemVisualsRequest> VisualsRequests;
+
+	/**
+	 * Internal use only. Requested assets and their priority by requester.
+	 */
+	TMap<TObjectKey<UObject>, TMap<FPrimaryAssetId, TAsyncLoadPriority>> RequestedAssetsByRequester;
+
+	/**
+	 * Internal use only. Start loading the bundle of an asset with the priority of its request. A running load is replaced.
+	 * The loaded callback can run right away, so no references into VisualsRequests may be held while calling this.
+	 *
+	 * @param Asset The asset to load.
+	 */
+	void StartLoading(const FPrimaryAssetId& Asset);
+
+	/**
+	 * Internal use only. Cancel or release the bundle of an asset that is no longer requested.
+	 *
+	 * @param Asset The asset to release.
+	 */
+	void ReleaseAsset(const FPrimaryAssetId& Asset);
+
+	/**
+	 * Called by the streamable manager after the bundle of an asset was loaded.
+	 *
+	 * @param Asset The loaded asset.
+	 */
+	void HandleVisualsLoaded(const FPrimaryAssetId Asset);
+
+public:
+	/**
+	 * Asset bundle loaded by this subsystem.
+	 */
+	static const FName VisualsBundleName;
+
+	/**
+	 * Delegate used to add functionality after the visuals of an item were loaded.
+	 */
+	UPROPERTY(BlueprintAssignable, BlueprintCallable)
+	FItemVisualsLoadedDelegate ItemVisualsLoadedDelegate;
+
+	/**
+	 * Get the subsystem of the game instance.
+	 *
+	 * @param WorldContextObject Any object with a world.
+	 * @return The subsystem or nullptr.
+	 */
+	static UItemVisualsPreloadSubsystem* Get(const UObject* WorldContextObject);
+
+	virtual void Deinitialize() override;
+
+	/**
+	 * Replace the assets requested by a requester. Assets missing in the new request are cancelled or released if no other requester uses them.
+	 *
+	 * @param Requester			The object owning the request, for example a widget.
+	 * @param VisibleAssets		Assets of visible slots, loaded with high priority.
+	 * @param AdjacentAssets	Assets of adjacent pages, loaded with default priority.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Inventory System")
+	void RequestItemVisuals(UObject* Requester, const TArray<FPrimaryAssetId>& VisibleAssets, const TArray<FPrimaryAssetId>& AdjacentAssets);
+
+	/**
+	 * Request the visuals of a range of inventory slots and the slots around it.
+	 *
+	 * @param Requester			The object owning the request, for example a widget.
+	 * @param ItemContainerComponent The component of the slots.
+	 * @param FirstSlot			First visible inventory slot.
+	 * @param LastSlot			Last visible inventory slot.
+	 * @param AdjacentSlots		Number of slots before and after the visible slots loaded with default priority.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Inventory System")
+	void PreloadInventorySlots(UObject* Requester, const UItemContainerComponent* ItemContainerComponent, const int FirstSlot, const int LastSlot, const int AdjacentSlots = 0);
+
+	/**
+	 * Remove all requests of a requester.
+	 *
+	 * @param Requester The object owning the request.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Inventory System")
+	void ReleaseItemVisuals(UObject* Requester);
+
+	/**
+	 * Get the load state of the visuals of an asset.
+	 *
+	 * @param Asset The asset.
+	 * @return The load state.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Inventory System")
+	EItemVisualsLoadState GetItemVisualsLoadState(const FPrimaryAssetId& Asset) const;
+};
+
+#undef LOCTEXT_NAMESPACE
@@ -4,12 +4,13 @@
 
 #include "EquipmentSlots.h"
 #include "Components/Overlay.h"
-#include "TimerManager.h"
 #include "UI_EquipmentItem.generated.h"
 
 #define LOCTEXT_NAMESPACE "InventorySystem"
 
 class UInventorySystemComponent;
+class UItemContainerComponent;
+class UInventorySystemWidgetSubsystem;
 
 /**
  * Delegate for handling equipment slot changes. Can be used to bind custom functionality when the equipment slot is updated.
@@ -42,29 +43,43 @@ class INVENTORYSYSTEM_API UUI_EquipmentItem : public UOverlay
 protected:
     UUI_EquipmentItem();
 
-    /**
-    * Handles the initialization timing for setting up the equipment slot.
-    */
-    FTimerHandle InitEquipmentSlotTimerHandle;
-
     /**
     * Handle removal of delegates here.
     */
     virtual void FinishDestroy() override;
 
     /**
-    * Initializes the equipment slot, setting up necessary references and data.
+    * Initializes the equipment slot, setting up necessary references and data. If no component is found yet, HandleResolvedComponentsChanged initializes it once UInventorySystemWidgetSubsystem resolved one.
     */
     UFUNCTION()
     void InitEquipmentSlot();
 
     /**
-     * Calls the change delegate with a list of changed equipment slots. Primarily used internally to handle updates.
+     * Calls the change delegate. Called by the slot subscription of the used component.
      *
-     * @param EquipmentSlots 
+     * @param ChangedEquipmentSlot The changed equipment slot.
      */
-    UFUNCTION()
-    void CallChangeDelegate(const TArray<int>& EquipmentSlots);
+    void CallChangeDelegate(const int ChangedEquipmentSlot);
+
+    /**
+     * Component the slot subscription was created on.
+     */
+    TWeakObjectPtr<UInventorySystemComponent> SubscribedInventorySystemComponent;
+
+    /**
+     * Equipment slot the subscription was created for.
+     */
+    int SubscribedEquipmentSlot = INDEX_NONE;
+
+    /**
+     * Handle of the slot subscription.
+     */
+    FDelegateHandle EquipmentSlotSubscriptionHandle;
+
+    /**
+     * Remove the slot subscription from the component if there is one.
+     */
+    void UnsubscribeEquipmentSlot();
 
     /**
      * A custom inventory system component, set if not using the one from the player state.
@@ -73,10 +88,29 @@ protected:
     UInventorySystemComponent* CustomInventorySystemComponent = nullptr;
 
     /**
-     * Automatically detected inventory system component from the player state.
+     * Handle of the subscription to UInventorySystemWidgetSubsystem::ResolvedPlayerComponentsChangedDelegate.
      */
-    UPROPERTY()
-    UInventorySystemComponent* PlayerStateInventorySystemComponent = nullptr;
+    FDelegateHandle ResolvedComponentsChangedHandle;
+
+    /**
+     * Subsystem the resolved components subscription was created on. Used to remove it in FinishDestroy.
+     */
+    TWeakObjectPtr<UInventorySystemWidgetSubsystem> ResolvedComponentsSubsystem;
+
+    /**
+     * Move the slot subscription to the newly resolved player component.
+     */
+    void HandleResolvedComponentsChanged();
+
+    /**
+     * Equipment slot data returned by the last GetEquipmentSlotData call.
+     */
+    FEquipmentSlot CachedEquipmentSlotData;
+
+    /**
+     * Generation of the equipment slot CachedEquipmentSlotData was read at. INDEX_NONE if nothing was read yet.
+     */
+    int CachedEquipmentSlotGeneration = INDEX_NONE;
 
     /**
      * Rebuilds the widget, allowing for customization of the UI components based on the equipment slot data.
@@ -113,11 +147,19 @@ public:
     /**
      * Sets the equipment slot to be displayed by this widget. This should be set before the widget is initialized to
      * ensure the correct slot is displayed. It specifies which slot from the InventorySystemComponent's EquipmentSlots array
-     * to show.
+     * to show. Blueprint writes go through SetEquipmentSlot to keep the slot subscription up to date.
      */
-    UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "Inventory System")
+    UPROPERTY(BlueprintReadWrite, BlueprintSetter = SetEquipmentSlot, EditAnywhere, Category = "Inventory System")
     int EquipmentSlot = INDEX_NONE;
 
+    /**
+     * Change the displayed equipment slot after initialization and move the slot subscription to it.
+     *
+     * @param NewEquipmentSlot The new equipment slot.
+     */
+    UFUNCTION(BlueprintCallable, Category = "Inventory System")
+    void SetEquipmentSlot(const int NewEquipmentSlot);
+
     /**
      * Retrieves the data for the currently set equipment slot and returns it.
      *
@@ -125,6 +167,14 @@ public:
      */
     UFUNCTION(BlueprintCallable, Category = "Inventory System")
     FEquipmentSlot GetEquipmentSlotData();
+
+    /**
+     * Check if the equipment slot changed since the last GetEquipmentSlotData call. Use this to skip widget refreshes.
+     *
+     * @return True if the slot changed or was never read.
+     */
+    UFUNCTION(BlueprintCallable, Category = "Inventory System")
+    bool IsEquipmentSlotDataOutdated();
 };
 
 #undef LOCTEXT_NAMESPACE
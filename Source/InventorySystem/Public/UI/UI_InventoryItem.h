@@ -5,11 +5,11 @@
 #include "InventorySlots.h"
 #include "InventorySystemComponent.h"
 #include "Components/Overlay.h"
-#include "TimerManager.h"
 #include "UI_InventoryItem.generated.h"
 
 #define LOCTEXT_NAMESPACE "InventorySystem"
 
+class UInventorySystemWidgetSubsystem;
 class UItemContainerComponent;
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FInventorySlotChangedDelegate, bool, bRemoved);
@@ -41,11 +41,6 @@ class INVENTORYSYSTEM_API UUI_InventoryItem : public UOverlay
 protected:
     UUI_InventoryItem();
 
-    /**
-     * Handle for delayed initialization of inventory slot.
-     */
-    FTimerHandle InitInventorySlotTimerHandle;
-
     /**
      * Handle removal of delegates here.
      */
@@ -54,18 +49,37 @@ protected:
     
 
     /**
-    * Initializes the inventory slot, typically called after a delay to ensure all components are loaded.
+    * Initializes the inventory slot. If no component is found yet, HandleResolvedComponentsChanged initializes it once UInventorySystemWidgetSubsystem resolved one.
     */
     UFUNCTION()
     void InitInventorySlot();
 
     /**
-     * Triggers the inventory slot changed delegate with the specified inventory slots.
+     * Triggers the inventory slot changed delegate. Called by the slot subscription of the used component.
      *
-     * @param InventorySlots 
+     * @param ChangedInventorySlot The changed inventory slot.
      */
-    UFUNCTION()
-    void CallChangeDelegate(const TArray<int>& InventorySlots);
+    void CallChangeDelegate(const int ChangedInventorySlot);
+
+    /**
+     * Component the slot subscription was created on.
+     */
+    TWeakObjectPtr<UItemContainerComponent> SubscribedItemContainerComponent;
+
+    /**
+     * Inventory slot the subscription was created for.
+     */
+    int SubscribedInventorySlot = INDEX_NONE;
+
+    /**
+     * Handle of the slot subscription.
+     */
+    FDelegateHandle InventorySlotSubscriptionHandle;
+
+    /**
+     * Remove the slot subscription from the component if there is one.
+     */
+    void UnsubscribeInventorySlot();
 
     /**
      * Custom item container component, if set.
@@ -74,10 +88,19 @@ protected:
     UItemContainerComponent* CustomItemContainerComponent = nullptr;
 
     /**
-     * Automatically detected player state inventory system component.
+     * Handle of the subscription to UInventorySystemWidgetSubsystem::ResolvedPlayerComponentsChangedDelegate.
      */
-    UPROPERTY()
-    UInventorySystemComponent* PlayerStateInventorySystemComponent = nullptr;
+    FDelegateHandle ResolvedComponentsChangedHandle;
+
+    /**
+     * Subsystem the resolved components subscription was created on. Used to remove it in FinishDestroy.
+     */
+    TWeakObjectPtr<UInventorySystemWidgetSubsystem> ResolvedComponentsSubsystem;
+
+    /**
+     * Move the slot subscription to the newly resolved player component.
+     */
+    void HandleResolvedComponentsChanged();
 
     virtual TSharedRef<SWidget> RebuildWidget() override;
 public:
@@ -104,10 +127,19 @@ public:
 
     /**
      * Sets the inventory slot to be displayed by this widget. This should be set before interacting with the widget.
+     * Blueprint writes go through SetInventorySlot to keep the slot subscription up to date.
      */
-    UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "Inventory System")
+    UPROPERTY(BlueprintReadWrite, BlueprintSetter = SetInventorySlot, EditAnywhere, Category = "Inventory System")
     int InventorySlot = INDEX_NONE;
 
+    /**
+     * Change the displayed inventory slot after initialization and move the slot subscription to it.
+     *
+     * @param NewInventorySlot The new inventory slot.
+     */
+    UFUNCTION(BlueprintCallable, Category = "Inventory System")
+    void SetInventorySlot(const int NewInventorySlot);
+
     /**
      * Retrieves the data for the currently set inventory slot and returns it.
      * @return The data structure representing the current inventory slot's state.
@@ -0,0 +1,75 @@
+﻿// © 2024 Daniel Münch. All Rights Reserved
+
+#pragma once
+
+#include "InventorySlots.h"
+#include "Blueprint/IUserObjectListEntry.h"
+#include "Blueprint/UserWidget.h"
+#include "UI/ItemVisualsPreloadSubsystem.h"
+#include "UI/UI_InventoryItem.h"
+#include "UI_InventorySlotEntry.generated.h"
+
+#define LOCTEXT_NAMESPACE "InventorySystem"
+
+class UInventorySlotListItem;
+
+/**
+ * @class UUI_InventorySlotEntry
+ * @brief Base class for entry widgets of UUI_InventoryTileView.
+ *
+ * Entry widgets are only created for visible rows and are recycled while scrolling. Every time the widget
+ * is assigned to another inventory slot or the displayed slot changed, InventorySlotChangedDelegate is called.
+ *
+ * Usage:
+ * - Create a widget blueprint from this class and set it as entry widget class of UUI_InventoryTileView.
+ * - Bind InventorySlotChangedDelegate and read the slot with GetInventorySlotData.
+ */
+UCLASS(Abstract, Category = "Inventory System")
+class INVENTORYSYSTEM_API UUI_InventorySlotEntry : public UUserWidget, public IUserObjectListEntry
+{
+    GENERATED_BODY()
+
+protected:
+    /**
+     * List item currently displayed by this entry.
+     */
+    UPROPERTY()
+    UInventorySlotListItem* InventorySlotListItem = nullptr;
+
+    virtual void NativeOnListItemObjectSet(UObject* ListItemObject) override;
+
+public:
+    /**
+     * Delegate for adding functionality after the displayed slot was changed or the entry was assigned to another slot.
+     */
+    UPROPERTY(BlueprintAssignable, BlueprintCallable)
+    FInventorySlotChangedDelegate InventorySlotChangedDelegate;
+
+    /**
+     * Internal use only. Triggers the inventory slot changed delegate. Called by UUI_InventoryTileView for visible entries.
+     */
+    void CallChangeDelegate();
+
+    /**
+     * Get the inventory slot displayed by this entry.
+     * @return The inventory slot or INDEX_NONE if no list item is set.
+     */
+    UFUNCTION(BlueprintCallable, Category = "Inventory System")
+    int GetInventorySlot() const;
+
+    /**
+     * Retrieves the data of the displayed inventory slot.
+     * @return The data structure representing the current inventory slot's state.
+     */
+    UFUNCTION(BlueprintCallable, Category = "Inventory System")
+    FInventorySlot GetInventorySlotData() const;
+
+    /**
+     * Get the load state of the visuals of the displayed item. Show a placeholder while loading to avoid synchronous loads through GetIcon.
+     * @return The load state or NotRequested if the slot is empty.
+     */
+    UFUNCTION(BlueprintCallable, Category = "Inventory System")
+    EItemVisualsLoadState GetVisualsLoadState() const;
+};
+
+#undef LOCTEXT_NAMESPACE
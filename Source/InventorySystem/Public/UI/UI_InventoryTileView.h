@@ -0,0 +1,165 @@
+﻿// © 2024 Daniel Münch. All Rights Reserved
+
+#pragma once
+
+#include "Components/TileView.h"
+#include "UI_InventoryTileView.generated.h"
+
+#define LOCTEXT_NAMESPACE "InventorySystem"
+
+class UInventorySlotListItem;
+class UInventorySystemWidgetSubsystem;
+class UItemContainerComponent;
+
+/**
+ * @class UUI_InventoryTileView
+ * @brief Virtualized view of all inventory slots of an item container component.
+ *
+ * Unlike one UUI_InventoryItem per slot, entry widgets are only created for visible rows and are recycled while scrolling.
+ * Every slot is represented by a lightweight UInventorySlotListItem. Changed slots reported by
+ * UItemContainerComponent::ChangedInventorySlotsDelegate are forwarded to visible entries only.
+ *
+ * Usage:
+ * - Set a subclass of UUI_InventorySlotEntry as entry widget class.
+ * - Without a custom component, the item container component of the owning player's PlayerState is used.
+ *
+ * Example Usage:
+ * @code
+ * InventoryTileView->SetCustomItemContainerComponent(BankComponent);
+ * @endcode
+ */
+UCLASS(Category = "Inventory System")
+class INVENTORYSYSTEM_API UUI_InventoryTileView : public UTileView
+{
+    GENERATED_BODY()
+
+protected:
+    /**
+     * List items by inventory slot - 1.
+     */
+    UPROPERTY()
+    TArray<UInventorySlotListItem*> InventorySlotListItems;
+
+    /**
+     * Custom item container component, if set.
+     */
+    UPROPERTY()
+    UItemContainerComponent* CustomItemContainerComponent = nullptr;
+
+    /**
+     * Component the list items were created for.
+     */
+    TWeakObjectPtr<UItemContainerComponent> BoundItemContainerComponent;
+
+    /**
+     * Handle of the subscription to UInventorySystemWidgetSubsystem::ResolvedPlayerComponentsChangedDelegate.
+     */
+    FDelegateHandle ResolvedComponentsChangedHandle;
+
+    /**
+     * Subsystem the resolved components subscription was created on. Used to remove it in FinishDestroy.
+     */
+    TWeakObjectPtr<UInventorySystemWidgetSubsystem> ResolvedComponentsSubsystem;
+
+    /**
+     * Bind to the used component. If there is none yet, HandleResolvedComponentsChanged binds once UInventorySystemWidgetSubsystem resolved one.
+     */
+    void InitItemContainerComponent();
+
+    /**
+     * Create the list items of a component and bind to its changed slots.
+     *
+     * @param Component The component to display.
+     */
+    void BindItemContainerComponent(UItemContainerComponent* Component);
+
+    /**
+     * Remove the binding to the current component and clear the list.
+     */
+    void UnbindItemContainerComponent();
+
+    /**
+     * Update the list items to the inventory size of the bound component and refresh visible entries.
+     */
+    void RebuildInventorySlotListItems();
+
+    /**
+     * Forward changed slots to their visible entries.
+     *
+     * @param Slots The changed inventory slots.
+     */
+    UFUNCTION()
+    void HandleChangedInventorySlots(const TArray<int>& Slots);
+
+    /**
+     * Bind to the newly resolved player component.
+     */
+    void HandleResolvedComponentsChanged();
+
+    /**
+     * True if the list view events used for preloading are bound.
+     */
+    bool bIsPreloadBound = false;
+
+    /**
+     * True if a preload of the visible slots is scheduled for the next tick.
+     */
+    bool bIsPreloadPending = false;
+
+    /**
+     * Schedule a preload of the visible slots for the next tick, so multiple scroll and entry events only cause one request.
+     */
+    void SchedulePreloadItemVisuals();
+
+    /**
+     * Request the "Visuals" bundle of the visible slots and their adjacent pages from UItemVisualsPreloadSubsystem.
+     */
+    void PreloadItemVisuals();
+
+    /**
+     * Refresh visible entries showing the loaded asset.
+     *
+     * @param Asset The asset whose visuals were loaded.
+     */
+    UFUNCTION()
+    void HandleItemVisualsLoaded(const FPrimaryAssetId& Asset);
+
+    /**
+     * Handle removal of delegates here.
+     */
+    virtual void FinishDestroy() override;
+
+    virtual TSharedRef<SWidget> RebuildWidget() override;
+public:
+    /**
+     * Number of pages before and after the visible slots whose visuals are preloaded. A page is the number of visible entries.
+     * Set to INDEX_NONE to disable preloading.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Inventory System")
+    int PreloadAdjacentPages = 1;
+
+    /**
+     * Sets a custom ItemContainerComponent, for example a bank or chest.
+     * @param ItemContainerComponent The custom ItemContainerComponent to use.
+     */
+    UFUNCTION(BlueprintCallable, Category = "Inventory System")
+    void SetCustomItemContainerComponent(UItemContainerComponent* const& ItemContainerComponent);
+
+    /**
+     * Retrieves the ItemContainerComponent currently being used by this view.
+     * @return The active item container component.
+     */
+    UFUNCTION(BlueprintCallable, Category = "Inventory System")
+    UItemContainerComponent* GetUsedItemContainerComponent();
+
+    /**
+     * Get the list item of an inventory slot, for example to scroll to it with ScrollIndexIntoView or NavigateToItem.
+     *
+     * @param Slot The inventory slot.
+     * @return The list item or nullptr if the slot is out of range.
+     */
+    UFUNCTION(BlueprintCallable, Category = "Inventory System")
+    UInventorySlotListItem* GetInventorySlotListItem(const int Slot) const;
+};
+
+#undef LOCTEXT_NAMESPACE